@@ -90,6 +90,7 @@ ConsumerCbr::ScheduleNextPacket()
     m_sendEvent = Simulator::Schedule(Seconds(0.0), &ConsumerCbr::sendPackett, this);
     m_firstTime = false;
     // start timer for dispalying video data
+    m_playback = true;
     Simulator::Schedule(Seconds(1.0 / kDisplayRate), &ConsumerCbr::DisplayData, this);
   }
   else if (!m_sendEvent.IsRunning())
@@ -23,11 +23,38 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <thread>
+
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerZipfMandelbrot");
 
 namespace ns3 {
 namespace ndn {
 
+namespace {
+
+// catalogues smaller than this are built on the calling thread
+const uint32_t PARALLEL_BUILD_THRESHOLD = 65536;
+
+/**
+ * @brief Run fn(0), ..., fn(nThreads - 1) concurrently, fn(0) on the calling thread
+ */
+template<class Function>
+void
+parallelFor(unsigned nThreads, const Function& fn)
+{
+  std::vector<std::thread> threads;
+  for (unsigned t = 1; t < nThreads; t++) {
+    threads.emplace_back(fn, t);
+  }
+  fn(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+} // namespace
+
 NS_OBJECT_ENSURE_REGISTERED(ConsumerZipfMandelbrot);
 
 TypeId
@@ -52,7 +79,15 @@ ConsumerZipfMandelbrot::GetTypeId(void)
       .AddAttribute("s", "parameter of power", StringValue("0.7"),
                     MakeDoubleAccessor(&ConsumerZipfMandelbrot::SetS,
                                        &ConsumerZipfMandelbrot::GetS),
-                    MakeDoubleChecker<double>());
+                    MakeDoubleChecker<double>())
+
+      .AddAttribute("Sampler",
+                    "Method to draw content ranks: cumulative (binary search, default), alias "
+                    "(constant time, but consumes random numbers differently)",
+                    StringValue("cumulative"),
+                    MakeStringAccessor(&ConsumerZipfMandelbrot::SetSampler,
+                                       &ConsumerZipfMandelbrot::GetSampler),
+                    MakeStringChecker());
 
   return tid;
 }
@@ -61,6 +96,8 @@ ConsumerZipfMandelbrot::ConsumerZipfMandelbrot()
   : m_N(100) // needed here to make sure when SetQ/SetS are called, there is a valid value of N
   , m_q(0.7)
   , m_s(0.7)
+  , m_tablesValid(false)
+  , m_sampler(SAMPLER_CUMULATIVE)
   , m_seqRng(CreateObject<UniformRandomVariable>())
 {
   // SetNumberOfContents is called by NS-3 object system during the initialization
@@ -74,20 +111,92 @@ void
 ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
 {
   m_N = numOfContents;
+  m_tablesValid = false;
+}
 
+void
+ConsumerZipfMandelbrot::BuildTables()
+{
   NS_LOG_DEBUG(m_q << " and " << m_s << " and " << m_N);
 
   m_Pcum = std::vector<double>(m_N + 1);
-
   m_Pcum[0] = 0.0;
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
+
+  unsigned nThreads = 1;
+  if (m_N >= PARALLEL_BUILD_THRESHOLD) {
+    nThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  uint64_t chunk = (static_cast<uint64_t>(m_N) + nThreads - 1) / nThreads;
+
+  // each thread sums up its own range of ranks, partial sums are then shifted by the total
+  // weight of the preceding ranges and normalized
+  std::vector<double> offsets(nThreads, 0.0);
+  parallelFor(nThreads, [this, chunk, &offsets] (unsigned t) {
+      uint64_t begin = t * chunk + 1;
+      uint64_t end = std::min<uint64_t>(m_N, (t + 1) * chunk);
+      double sum = 0.0;
+      for (uint64_t i = begin; i <= end; i++) {
+        sum += 1.0 / std::pow(i + m_q, m_s);
+        m_Pcum[i] = sum;
+      }
+      offsets[t] = sum;
+    });
+
+  double total = 0.0;
+  for (auto& offset : offsets) {
+    double sum = offset;
+    offset = total;
+    total += sum;
+  }
+
+  parallelFor(nThreads, [this, chunk, &offsets, total] (unsigned t) {
+      uint64_t begin = t * chunk + 1;
+      uint64_t end = std::min<uint64_t>(m_N, (t + 1) * chunk);
+      for (uint64_t i = begin; i <= end; i++) {
+        m_Pcum[i] = (m_Pcum[i] + offsets[t]) / total;
+      }
+    });
+  if (m_N > 0) {
+    m_Pcum[m_N] = 1.0;
   }
 
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << m_Pcum[i]);
+  m_aliasProb.clear();
+  m_alias.clear();
+  if (m_sampler == SAMPLER_ALIAS && m_N > 0) {
+    // Vose's alias method: split ranks into under- and over-full columns of average height 1
+    // and top up each under-full column with the excess of an over-full one
+    m_aliasProb.resize(m_N);
+    m_alias.resize(m_N);
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (uint32_t i = 0; i < m_N; i++) {
+      m_aliasProb[i] = (m_Pcum[i + 1] - m_Pcum[i]) * m_N;
+      m_alias[i] = i + 1;
+      (m_aliasProb[i] < 1.0 ? small : large).push_back(i);
+    }
+
+    while (!small.empty() && !large.empty()) {
+      uint32_t less = small.back();
+      small.pop_back();
+      uint32_t more = large.back();
+
+      m_alias[less] = more + 1;
+      m_aliasProb[more] -= 1.0 - m_aliasProb[less];
+      if (m_aliasProb[more] < 1.0) {
+        large.pop_back();
+        small.push_back(more);
+      }
+    }
+    // leftovers differ from 1 only by rounding errors
+    for (uint32_t i : small) {
+      m_aliasProb[i] = 1.0;
+    }
+    for (uint32_t i : large) {
+      m_aliasProb[i] = 1.0;
+    }
   }
+
+  m_tablesValid = true;
 }
 
 uint32_t
@@ -100,7 +209,7 @@ void
 ConsumerZipfMandelbrot::SetQ(double q)
 {
   m_q = q;
-  SetNumberOfContents(m_N);
+  m_tablesValid = false;
 }
 
 double
@@ -113,7 +222,7 @@ void
 ConsumerZipfMandelbrot::SetS(double s)
 {
   m_s = s;
-  SetNumberOfContents(m_N);
+  m_tablesValid = false;
 }
 
 double
@@ -122,6 +231,27 @@ ConsumerZipfMandelbrot::GetS() const
   return m_s;
 }
 
+void
+ConsumerZipfMandelbrot::SetSampler(const std::string& sampler)
+{
+  if (sampler == "cumulative") {
+    m_sampler = SAMPLER_CUMULATIVE;
+  }
+  else if (sampler == "alias") {
+    m_sampler = SAMPLER_ALIAS;
+  }
+  else {
+    NS_FATAL_ERROR("Unknown Zipf-Mandelbrot sampler " << sampler);
+  }
+  m_tablesValid = false;
+}
+
+std::string
+ConsumerZipfMandelbrot::GetSampler() const
+{
+  return m_sampler == SAMPLER_ALIAS ? "alias" : "cumulative";
+}
+
 void
 ConsumerZipfMandelbrot::SendPacket()
 {
@@ -134,9 +264,17 @@ ConsumerZipfMandelbrot::SendPacket()
 
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s max -> " << m_seqMax << "\n";
 
-  while (m_retxSeqs.size()) {
-    seq = *m_retxSeqs.begin();
-    m_retxSeqs.erase(m_retxSeqs.begin());
+  while (m_retxQueue.size()) {
+    seq = m_retxQueue.front();
+    m_retxQueue.pop_front();
+
+    // skip sequence numbers whose Data has arrived in the meantime
+    SeqWindowTable::Entry* entry = m_seqStates.Find(seq);
+    if (entry == nullptr || !(entry->flags & SeqWindowTable::RETX)) {
+      seq = std::numeric_limits<uint32_t>::max();
+      continue;
+    }
+    entry->flags &= ~SeqWindowTable::RETX;
 
     // NS_ASSERT (m_seqLifetimes.find (seq) != m_seqLifetimes.end ());
     // if (m_seqLifetimes.find (seq)->time <= Simulator::Now ())
@@ -147,7 +285,7 @@ ConsumerZipfMandelbrot::SendPacket()
     //     sequence number
     //     continue;
     //   }
-    NS_LOG_DEBUG("=interest seq " << seq << " from m_retxSeqs");
+    NS_LOG_DEBUG("=interest seq " << seq << " from m_retxQueue");
     break;
   }
 
@@ -176,18 +314,7 @@ ConsumerZipfMandelbrot::SendPacket()
 
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId());
-  NS_LOG_DEBUG("Trying to add " << seq << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(seq, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqLastDelay.erase(seq);
-  m_seqLastDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqRetxCounts[seq]++;
-
-  m_rtt->SentSeq(SequenceNumber32(seq), 1);
+  WillSendOutInterest(seq);
 
   m_transmittedInterests(interest, this, m_face);
   m_appLink->onReceiveInterest(*interest);
@@ -195,31 +322,62 @@ ConsumerZipfMandelbrot::SendPacket()
   ConsumerZipfMandelbrot::ScheduleNextPacket();
 }
 
+void
+ConsumerZipfMandelbrot::OnTimeout(uint32_t sequenceNumber)
+{
+  // RETX flag is set while the sequence number waits in m_retxQueue
+  SeqWindowTable::Entry* entry = m_seqStates.Find(sequenceNumber);
+  bool isQueued = entry != nullptr && (entry->flags & SeqWindowTable::RETX);
+
+  Consumer::OnTimeout(sequenceNumber);
+  if (!isQueued) {
+    m_retxQueue.push_back(sequenceNumber);
+  }
+}
+
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
-  uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
+  if (!m_tablesValid) {
+    BuildTables();
+  }
 
   double p_random = m_seqRng->GetValue();
   while (p_random == 0) {
     p_random = m_seqRng->GetValue();
   }
-  // if (p_random == 0)
   NS_LOG_LOGIC("p_random=" << p_random);
-  for (uint32_t i = 1; i <= m_N; i++) {
-    p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-                       // p_cum[2] = p[1] + p[2]
-    if (p_random <= p_sum) {
-      content_index = i;
-      break;
-    } // if
-  }   // for
-  // content_index = 1;
+
+  uint32_t content_index = m_sampler == SAMPLER_ALIAS ? SampleAlias(p_random)
+                                                      : SampleCumulative(p_random);
   NS_LOG_DEBUG("RandomNumber=" << content_index);
   return content_index;
 }
 
+uint32_t
+ConsumerZipfMandelbrot::SampleCumulative(double p) const
+{
+  // first rank i in [1, m_N] with p <= m_Pcum[i]
+  auto it = std::lower_bound(m_Pcum.begin() + 1, m_Pcum.end(), p);
+  if (it == m_Pcum.end()) {
+    return 1;
+  }
+  return it - m_Pcum.begin();
+}
+
+uint32_t
+ConsumerZipfMandelbrot::SampleAlias(double p) const
+{
+  if (m_N == 0) {
+    return 1;
+  }
+
+  // integer part of p * N picks the column, fractional part decides between it and its alias
+  double x = p * m_N;
+  uint32_t column = std::min(static_cast<uint32_t>(x), m_N - 1);
+  return (x - column) < m_aliasProb[column] ? column + 1 : m_alias[column];
+}
+
 void
 ConsumerZipfMandelbrot::ScheduleNextPacket()
 {
@@ -64,6 +64,9 @@ public:
   virtual void
   SendPacket();
 
+  virtual void
+  OnTimeout(uint32_t sequenceNumber);
+
   uint32_t
   GetNextSeq();
 
@@ -90,13 +93,52 @@ private:
   double
   GetS() const;
 
+  void
+  SetSampler(const std::string& sampler);
+
+  std::string
+  GetSampler() const;
+
+  /**
+   * @brief (Re)build the cumulative and alias tables if N, q or s have changed
+   *
+   * Attribute setters only invalidate the tables, so initialization of the three attributes
+   * results in a single build, right before the first draw.
+   */
+  void
+  BuildTables();
+
+  /**
+   * @brief Draw a rank by binary search over the cumulative probabilities, O(log N)
+   */
+  uint32_t
+  SampleCumulative(double p) const;
+
+  /**
+   * @brief Draw a rank from the alias table (Vose's method), O(1)
+   */
+  uint32_t
+  SampleAlias(double p) const;
+
 private:
+  enum Sampler {
+    SAMPLER_CUMULATIVE, // binary search over m_Pcum
+    SAMPLER_ALIAS       // alias table
+  };
+
   uint32_t m_N;               // number of the contents
   double m_q;                 // q in (k+q)^s
   double m_s;                 // s in (k+q)^s
   std::vector<double> m_Pcum; // cumulative probability
+  bool m_tablesValid;         // whether the tables match current N, q and s
+
+  Sampler m_sampler;               // parsed "Sampler" attribute
+  std::vector<double> m_aliasProb; // alias table: probability to keep the drawn column
+  std::vector<uint32_t> m_alias;   // alias table: rank to use otherwise
 
   Ptr<UniformRandomVariable> m_seqRng; // RNG
+
+  std::deque<uint32_t> m_retxQueue; // sequence numbers to be retransmitted, in timeout order
 };
 
 } /* namespace ndn */
@@ -33,11 +33,14 @@
 #include "utils/ndn-rtt-mean-deviation.hpp"
 
 #include <ndn-cxx/lp/tags.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/ref.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 
+#include <cstring>
+
 #include "precache-strategy/send-more-interest.hpp"
 
 NS_LOG_COMPONENT_DEFINE("ndn.Consumer");
@@ -77,6 +80,11 @@ Consumer::GetTypeId(void)
     .AddAttribute("HitChance", "Probability to prefetch each pkt", UintegerValue(100),
                   MakeUintegerAccessor(&Consumer::m_chance), MakeUintegerChecker<uint64_t>())
 
+    .AddAttribute("RttWindow", "Number of most recent RTT samples used for the RTT trend",
+                  UintegerValue(kRttVectorMaxSize),
+                  MakeUintegerAccessor(&Consumer::GetRttWindow, &Consumer::SetRttWindow),
+                  MakeUintegerChecker<uint32_t>(1))
+
     .AddAttribute("RetxTimer",
                   "Timeout defining how frequent retransmission timeouts should be checked",
                   StringValue("200ms"),
@@ -100,17 +108,30 @@ Consumer::Consumer()
   : m_rand(CreateObject<UniformRandomVariable>())
   , m_seq(0)
   , m_seqMax(0) // don't request anything
+  , m_playback(false)
+  , m_nonceOffset(0)
+  , m_seqTimeouts([this] { return m_rtt->RetransmitTimeout(); },
+                  [this] (uint32_t seq) { OnTimeout(seq); })
   , rengine_(rdevice_())
 {
   NS_LOG_FUNCTION_NOARGS();
 
   m_rtt = CreateObject<RttMeanDeviation>();
+  m_prefetch.reset(new PrefetchController());
   avoidSeqStart = avoidSeqEnd = 0;
 }
 
+Consumer::~Consumer()
+{
+}
+
 Address
 Consumer::GetCurrentAP()
 {
+  if (m_association != nullptr) {
+    return m_association->GetBssid();
+  }
+
   Ptr<ns3::WifiNetDevice> wifiDev = GetNode()->GetDevice(0)->GetObject<ns3::WifiNetDevice>();
   assert(wifiDev != nullptr);
   Ptr<ns3::StaWifiMac> staMac = wifiDev->GetMac()->GetObject<ns3::StaWifiMac>();
@@ -124,13 +145,7 @@ void
 Consumer::SetRetxTimer(Time retxTimer)
 {
   m_retxTimer = retxTimer;
-  if (m_retxEvent.IsRunning()) {
-    // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
-    Simulator::Remove(m_retxEvent); // slower, but better for memory
-  }
-
-  // schedule even with new timeout
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  m_seqTimeouts.SetGranularity(m_retxTimer);
 }
 
 Time
@@ -140,27 +155,16 @@ Consumer::GetRetxTimer() const
 }
 
 void
-Consumer::CheckRetxTimeout()
+Consumer::SetRttWindow(uint32_t rttWindow)
 {
-  Time now = Simulator::Now();
-
-  Time rto = m_rtt->RetransmitTimeout();
-  // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
-
-  while (!m_seqTimeouts.empty()) {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    if (entry->time + rto <= now) // timeout expired?
-      {
-        uint32_t seqNo = entry->seq;
-        m_seqTimeouts.get<i_timestamp>().erase(entry);
-        OnTimeout(seqNo);
-      }
-    else
-      break; // nothing else to do. All later packets need not be retransmitted
-  }
+  traffic_info.real_rtt.SetWindowSize(rttWindow);
+  traffic_info.est_rtt.clear();
+}
 
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+uint32_t
+Consumer::GetRttWindow() const
+{
+  return traffic_info.real_rtt.GetWindowSize();
 }
 
 // Application Methods
@@ -172,6 +176,16 @@ Consumer::StartApplication() // Called at time specified by Start
   // do base stuff
   App::StartApplication();
 
+  BuildInterestTemplate();
+
+  Ptr<CoverageOracle> coverage = GetNode()->GetObject<CoverageOracle>();
+  if ((m_step2 || m_step3) && coverage == nullptr) {
+    NS_FATAL_ERROR("Step2/Step3 require CoverageOracle to be installed on node " << GetNode()->GetId());
+  }
+  m_prefetch->SetCoverage(coverage);
+
+  m_association = GetNode()->GetObject<WifiAssociation>();
+
   ScheduleNextPacket();
 }
 
@@ -188,20 +202,64 @@ Consumer::StopApplication() // Called at time specified by Stop
 }
 
 void
-Consumer::SendGeneralInterestToFace257(uint32_t seq)
+Consumer::BuildInterestTemplate()
 {
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-  nameWithSequence->append(std::to_string(seq));
-  nameWithSequence->appendSequenceNumber(seq);
+  Interest interest;
+  interest.setInterestLifetime(time::milliseconds(m_interestLifeTime.GetMilliSeconds()));
+  interest.setNonce(0);
+
+  // everything after the Name does not depend on the sequence number, except the nonce value
+  const Block& wire = interest.wireEncode();
+  wire.parse();
+  const Block& nameBlock = wire.get(::ndn::tlv::Name);
+  const Block& nonceBlock = wire.get(::ndn::tlv::Nonce);
+  m_interestTail = make_shared< ::ndn::Buffer>(nameBlock.end(), wire.value_end());
+  m_nonceOffset = nonceBlock.value_begin() - nameBlock.end();
+
+  const Block& prefixBlock = m_interestName.wireEncode();
+  m_interestPrefix = make_shared< ::ndn::Buffer>(prefixBlock.value_begin(), prefixBlock.value_end());
+}
 
-  shared_ptr<Interest> interest = make_shared<Interest>();
-  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*nameWithSequence);
+shared_ptr<Interest>
+Consumer::PrepareInterest(uint32_t seq)
+{
+  // Interest = [Name][pre-encoded Nonce, InterestLifetime]
+  ::ndn::EncodingBuffer encoder(m_interestPrefix->size() + m_interestTail->size() + 32, 0);
+  size_t valueLength = encoder.prependByteArray(m_interestTail->data(), m_interestTail->size());
+
+  uint32_t nonce = m_rand->GetValue(0, std::numeric_limits<uint32_t>::max());
+  std::memcpy(encoder.buf() + m_nonceOffset, &nonce, sizeof(nonce));
+
+  SeqWindowTable::Entry* entry = m_seqStates.Find(seq);
+  if (entry != nullptr && entry->interest != nullptr) {
+    // retransmission: the name is already encoded
+    const Block& nameBlock = entry->interest->getName().wireEncode();
+    valueLength += encoder.prependByteArray(nameBlock.wire(), nameBlock.size());
+  }
+  else {
+    // Name = [pre-encoded prefix]/<seq>/<seq as sequence number>
+    size_t nameLength = name::Component::fromSequenceNumber(seq).wireEncode(encoder);
+    nameLength += name::Component(std::to_string(seq)).wireEncode(encoder);
+    nameLength += encoder.prependByteArray(m_interestPrefix->data(), m_interestPrefix->size());
+    nameLength += encoder.prependVarNumber(nameLength);
+    nameLength += encoder.prependVarNumber(::ndn::tlv::Name);
+    valueLength += nameLength;
+  }
+
+  encoder.prependVarNumber(valueLength);
+  encoder.prependVarNumber(::ndn::tlv::Interest);
+
+  return make_shared<Interest>(encoder.block());
+}
+
+void
+Consumer::SendGeneralInterestToFace257(uint32_t seq)
+{
+  shared_ptr<Interest> interest = PrepareInterest(seq);
   interest->setTag<lp::NextHopFaceIdTag>(make_shared<lp::NextHopFaceIdTag>(257));
-  time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
-  interest->setInterestLifetime(interestLifeTime);
 
   WillSendOutInterest(seq);
+  m_seqStates.Get(seq).interest = interest;
 
   m_transmittedInterests(interest, this, m_face);
   m_appLink->onReceiveInterest(*interest);
@@ -210,17 +268,11 @@ Consumer::SendGeneralInterestToFace257(uint32_t seq)
 void
 Consumer::SendGeneralInterest(uint32_t seq)
 {
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-  nameWithSequence->append(std::to_string(seq));
-  nameWithSequence->appendSequenceNumber(seq);
-
-  shared_ptr<Interest> interest = make_shared<Interest>();
-  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*nameWithSequence);
-  time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
-  interest->setInterestLifetime(interestLifeTime);
+  shared_ptr<Interest> interest = PrepareInterest(seq);
+  interest->removeTag<lp::NextHopFaceIdTag>();
 
   WillSendOutInterest(seq);
+  m_seqStates.Get(seq).interest = interest;
 
   m_transmittedInterests(interest, this, m_face);
   m_appLink->onReceiveInterest(*interest);
@@ -229,13 +281,7 @@ Consumer::SendGeneralInterest(uint32_t seq)
 void
 Consumer::SendPrefetchInterest(uint32_t seq)
 {
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-  nameWithSequence->append(std::to_string(seq));
-  nameWithSequence->appendSequenceNumber(seq);
-
-  shared_ptr<Interest> interest = make_shared<Interest>();
-  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*nameWithSequence);
+  shared_ptr<Interest> interest = PrepareInterest(seq);
   time::milliseconds interestLifeTime(4000);
   interest->setInterestLifetime(interestLifeTime);
 
@@ -249,10 +295,14 @@ Consumer::SendBundledInterest(int seq1, int seq2) {
   nameWithSequence->append(m_interestName);
   nameWithSequence->appendNumber(seq1);
   nameWithSequence->appendNumber(seq2);
-  Address ap = GetCurrentAP();
-  std::ostringstream os;
-  os << ap;
-  nameWithSequence->append(os.str().c_str());
+  if (m_association != nullptr) {
+    nameWithSequence->append(m_association->GetBssidString());
+  }
+  else {
+    std::ostringstream os;
+    os << GetCurrentAP();
+    nameWithSequence->append(os.str().c_str());
+  }
 
   shared_ptr<Interest> interest = make_shared<Interest>();
   interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
@@ -276,7 +326,7 @@ Consumer::SendPacket(int frequency)
     std::vector<uint32_t> pre_fetch_seq;
     bool dumpRtxQueue = false;
     bool hasCoverage = false;
-    std::tie(pre_fetch_seq, dumpRtxQueue, hasCoverage) = ns3::moreInterestsToSend(m_seq, traffic_info, frequency);
+    std::tie(pre_fetch_seq, dumpRtxQueue, hasCoverage) = m_prefetch->MoreInterestsToSend(m_seq, traffic_info, frequency);
     if (pre_fetch_seq.size() > 0) {
       SendBundledInterest(m_seq + 1, m_seq + 1 + 70);
     }
@@ -296,7 +346,7 @@ Consumer::SendPacket(int frequency)
       std::vector<uint32_t> pre_fetch_seq;
       bool dumpRtxQueue = false;
       bool hasCoverage = false;
-      std::tie(pre_fetch_seq, dumpRtxQueue, hasCoverage) = ns3::moreInterestsToSend(m_seq, traffic_info, 20);
+      std::tie(pre_fetch_seq, dumpRtxQueue, hasCoverage) = m_prefetch->MoreInterestsToSend(m_seq, traffic_info, 20);
       if (!hasCoverage) {
         SendGeneralInterestToFace257(seq);
         NS_LOG_INFO("> Interest for " << seq << " Through Ad Hoc Face");
@@ -330,7 +380,7 @@ Consumer::SendPacket(int frequency)
 
   //   std::vector<uint32_t> pre_fetch_seq;
   //   bool dumpRtxQueue = false;
-  //   std::tie(pre_fetch_seq, dumpRtxQueue, hasCoverage) = ns3::moreInterestsToSend(m_seq, traffic_info, frequency);
+  //   std::tie(pre_fetch_seq, dumpRtxQueue, hasCoverage) = m_prefetch->MoreInterestsToSend(m_seq, traffic_info, frequency);
   //   NS_LOG_INFO ("ALGO RESULT: " << pre_fetch_seq.size() << " " << dumpRtxQueue << " "  << hasCoverage);
   //   if (pre_fetch_seq.size() > 0) {
   //     NS_LOG_INFO ("CURRENT FREQUENCY: " << frequency);
@@ -368,7 +418,7 @@ Consumer::SendPacket(int frequency)
 
   //   std::vector<uint32_t> pre_fetch_seq;
   //   bool dumpRtxQueue = false;
-  //   std::tie(pre_fetch_seq, dumpRtxQueue, hasCoverage) = ns3::moreInterestsToSend(m_seq, traffic_info, frequency);
+  //   std::tie(pre_fetch_seq, dumpRtxQueue, hasCoverage) = m_prefetch->MoreInterestsToSend(m_seq, traffic_info, frequency);
   // }
 
   // ///////////////////////////////////////////
@@ -426,38 +476,34 @@ Consumer::OnData(shared_ptr<const Data> data)
   }
   NS_LOG_DEBUG("Hop count: " << hopCount);
 
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
+  SeqWindowTable::Entry* entry = m_seqStates.Find(seq);
 
   // calculate the current real rtt
-  assert(entry != m_seqLastDelay.end());
-  int64_t cur_real_rtt = (Simulator::Now() - entry->time).GetNanoSeconds();
+  assert(entry != nullptr && (entry->flags & SeqWindowTable::PENDING));
+  int64_t cur_real_rtt = (Simulator::Now() - entry->lastSent).GetNanoSeconds();
 
-  if (entry != m_seqLastDelay.end()) {
-    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->time, hopCount);
-  }
+  m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->lastSent, hopCount);
+  m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->firstSent, entry->retxCount, hopCount);
 
-  entry = m_seqFullDelay.find(seq);
-  if (entry != m_seqFullDelay.end()) {
-    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
+  m_seqTimeouts.Erase(seq);
+  if (m_playback) {
+    // keep the entry until the playback consumes it
+    entry->flags = SeqWindowTable::IN_USE | SeqWindowTable::RECEIVED;
+    entry->interest.reset();
+  }
+  else {
+    m_seqStates.Release(seq);
   }
-
-  m_seqRetxCounts.erase(seq);
-  m_seqFullDelay.erase(seq);
-  m_seqLastDelay.erase(seq);
-
-  m_seqTimeouts.erase(seq);
-  m_retxSeqs.erase(seq);
 
   m_rtt->AckSeq(SequenceNumber32(seq));
 
   // calculate the current estimated rtt
   int64_t cur_est_rtt = m_rtt->GetCurrentEstimate().GetNanoSeconds();
   // add the current traffic info
-  if (traffic_info.real_rtt.size() == kRttVectorMaxSize) {
-    traffic_info.real_rtt.pop_front();
+  traffic_info.real_rtt.AddSample(cur_real_rtt, Simulator::Now().GetNanoSeconds());
+  if (traffic_info.est_rtt.size() == traffic_info.real_rtt.GetWindowSize()) {
     traffic_info.est_rtt.pop_front();
   }
-  traffic_info.real_rtt.push_back(cur_real_rtt);
   traffic_info.est_rtt.push_back(cur_est_rtt);
 
   // send next interest
@@ -474,7 +520,7 @@ Consumer::OnData(shared_ptr<const Data> data)
     std::vector<uint32_t> pre_fetch_seq;
     bool dumpRtxQueue = false;
     bool hasCoverage = false;
-    std::tie(pre_fetch_seq, dumpRtxQueue, hasCoverage) = ns3::moreInterestsToSend(m_seq, traffic_info, 20);
+    std::tie(pre_fetch_seq, dumpRtxQueue, hasCoverage) = m_prefetch->MoreInterestsToSend(m_seq, traffic_info, 20);
     if (!hasCoverage) {
       if (rand() % 100 < m_chance) {
         SendGeneralInterestToFace257(seq);
@@ -511,13 +557,13 @@ Consumer::OnTimeout(uint32_t sequenceNumber)
 {
   NS_LOG_FUNCTION(sequenceNumber);
   m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1); // make sure to disable RTT calculation for this sample
-  m_retxSeqs.insert(sequenceNumber);
+  m_seqStates.Get(sequenceNumber).flags |= SeqWindowTable::RETX;
 
   if (m_step3) {
     std::vector<uint32_t> pre_fetch_seq;
     bool dumpRtxQueue = false;
     bool hasCoverage = false;
-    std::tie(pre_fetch_seq, dumpRtxQueue, hasCoverage) = ns3::moreInterestsToSend(m_seq, traffic_info, 20);
+    std::tie(pre_fetch_seq, dumpRtxQueue, hasCoverage) = m_prefetch->MoreInterestsToSend(m_seq, traffic_info, 20);
     if (!hasCoverage) {
       SendGeneralInterestToFace257(sequenceNumber);
       NS_LOG_INFO("> Interest for " << sequenceNumber << " Through Ad Hoc Face");
@@ -556,13 +602,16 @@ Consumer::WillSendOutInterest(uint32_t sequenceNumber)
   NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
                << m_seqTimeouts.size() << " items");
 
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-
-  m_seqLastDelay.erase(sequenceNumber);
-  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+  m_seqTimeouts.Insert(sequenceNumber, Simulator::Now());
 
-  m_seqRetxCounts[sequenceNumber]++;
+  SeqWindowTable::Entry& entry = m_seqStates.Get(sequenceNumber);
+  if (!(entry.flags & SeqWindowTable::PENDING)) {
+    entry.firstSent = Simulator::Now();
+    entry.retxCount = 0;
+    entry.flags |= SeqWindowTable::PENDING;
+  }
+  entry.lastSent = Simulator::Now();
+  entry.retxCount++;
 
   m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
 
@@ -573,10 +622,12 @@ Consumer::WillSendOutInterest(uint32_t sequenceNumber)
 bool
 Consumer::GetSeqFromCache(uint32_t seq)
 {
-  if (data_cache.find(seq) == data_cache.end()) {
+  SeqWindowTable::Entry* entry = m_seqStates.Find(seq);
+  if (entry == nullptr || !(entry->flags & SeqWindowTable::RECEIVED)) {
     return false;
   }
-  data_cache.erase(seq);
+  // displayed, the state is not needed anymore
+  m_seqStates.Release(seq);
   return true;
 }
 
@@ -30,12 +30,18 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
+#include "ns3/ndnSIM/utils/ndn-retx-timer-wheel.hpp"
+#include "ns3/ndnSIM/utils/ndn-seq-window-table.hpp"
+#include "ns3/ndnSIM/apps/precache-strategy/coverage-oracle.hpp"
+#include "ns3/ndnSIM/apps/precache-strategy/rtt-trend-estimator.hpp"
+#include "ns3/ndnSIM/model/ndn-wifi-association.hpp"
 
 #include <set>
 #include <map>
 #include <unordered_set>
 #include <deque>
 #include <random>
+#include <memory>
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/tag.hpp>
@@ -45,6 +51,8 @@
 namespace ns3 {
 namespace ndn {
 
+class PrefetchController;
+
 /**
  * @ingroup ndn-apps
  * \brief NDN application for sending out Interest packets
@@ -59,8 +67,12 @@ public:
    * Sets up randomizer function and packet sequence number
    */
   Consumer();
-  virtual ~Consumer(){};
+  virtual ~Consumer();
 
+  /**
+   * \brief Get BSSID of the AP the node is associated with (cached if MobilityRoutingHelper
+   *        is installed on the node)
+   */
   Address
   GetCurrentAP();
 
@@ -86,9 +98,9 @@ public:
   SendPacket(int freqency = 0);
 
   /**
-   * @brief Get the data(seq) from cache(data_cache)
+   * @brief Get the data(seq) from cache (received Data kept for the playback)
    * @param sequenceNumber to be fetched
-   * @return if fetched successfully (the data_cache may not contain this seq)
+   * @return if fetched successfully (the Data of this seq may not be received yet)
   */
   bool
   GetSeqFromCache(uint32_t seq);
@@ -111,7 +123,8 @@ public:
   typedef void (*FirstInterestDataDelayCallback)(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount, int32_t hopCount);
 
   struct TrafficInfo {
-    std::deque<int64_t> real_rtt;
+    RttTrendEstimator real_rtt; ///< @brief trend of the most recent real RTTs
+
     std::deque<int64_t> est_rtt;
     std::deque<int64_t> retx_time;
   };
@@ -134,6 +147,24 @@ protected:
   virtual void
   ScheduleNextPacket() = 0;
 
+  /**
+   * \brief Get Interest for @p seq with a fresh nonce
+   *
+   * The Interest is encoded directly from the pre-encoded name prefix and the pre-encoded
+   * Nonce/InterestLifetime elements (see BuildInterestTemplate), only the two sequence
+   * components and the nonce value are written per Interest.  A retransmission copies the
+   * encoded name of the previous transmission of @p seq.  Interests that have been sent are
+   * never modified, as the forwarder may still hold them.
+   */
+  shared_ptr<Interest>
+  PrepareInterest(uint32_t seq);
+
+  /**
+   * \brief Encode the parts of the Interest that are the same for all sequence numbers
+   */
+  void
+  BuildInterestTemplate();
+
   void
   SendGeneralInterest(uint32_t seq);
 
@@ -146,15 +177,11 @@ protected:
   void
   SendBundledInterest(int seq1, int seq2);
 
-  /**
-   * \brief Checks if the packet need to be retransmitted becuase of retransmission timer expiration
-   */
-  void
-  CheckRetxTimeout();
-
   /**
    * \brief Modifies the frequency of checking the retransmission timeouts
    * \param retxTimer Timeout defining how frequent retransmission timeouts should be checked
+   *
+   * This is the slot duration of the retransmission timer wheel.
    */
   void
   SetRetxTimer(Time retxTimer);
@@ -166,30 +193,37 @@ protected:
   Time
   GetRetxTimer() const;
 
+  /**
+   * \brief Sets the number of most recent RTT samples used for the RTT trend
+   */
+  void
+  SetRttWindow(uint32_t rttWindow);
+
+  uint32_t
+  GetRttWindow() const;
+
 protected:
   Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
 
   uint32_t m_seq;      ///< @brief currently requested sequence number
   uint32_t m_seqMax;   ///< @brief maximum number of sequence number
+  bool m_playback;     ///< @brief keep state of received Data until it is fetched by GetSeqFromCache
   EventId m_sendEvent; ///< @brief EventId of pending "send packet" event
   Time m_retxTimer;    ///< @brief Currently estimated retransmission timer
-  EventId m_retxEvent; ///< @brief Event to check whether or not retransmission should be performed
 
   Ptr<RttEstimator> m_rtt; ///< @brief RTT estimator
 
   Time m_offTime;          ///< \brief Time interval between packets
   Name m_interestName;     ///< \brief NDN Name of the Interest (use Name)
   Time m_interestLifeTime; ///< \brief LifeTime for interest packet
+  /// \brief encoded components of m_interestName (value of the Name element)
+  shared_ptr<const ::ndn::Buffer> m_interestPrefix;
+  /// \brief encoded elements after the Name (Nonce, InterestLifetime), shared by all Interests
+  shared_ptr<const ::ndn::Buffer> m_interestTail;
+  size_t m_nonceOffset; ///< \brief position of the nonce value in m_interestTail
+  Ptr<WifiAssociation> m_association; ///< \brief AP of the node, set by MobilityRoutingHelper
 
   /// @cond include_hidden
-  /**
-   * \struct This struct contains sequence numbers of packets to be retransmitted
-   */
-  struct RetxSeqsContainer : public std::set<uint32_t> {
-  };
-
-  RetxSeqsContainer m_retxSeqs; ///< \brief ordered set of sequence numbers to be retransmitted
-
   /**
    * \struct This struct contains a pair of packet sequence number and its timeout
    */
@@ -233,12 +267,10 @@ protected:
                                                                          &SeqTimeout::time>>>> {
   };
 
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
+  RetxTimerWheel m_seqTimeouts; ///< \brief retransmission timeouts of outstanding Interests
   SeqTimeoutsContainer m_preFetchSeq; /// record the interest for precache
 
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  SeqWindowTable m_seqStates; ///< \brief send times, retx counts and status of each sequence number
 
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
     m_lastRetransmittedInterestDataDelay;
@@ -248,8 +280,7 @@ protected:
 
   // used for pre-cache project
   TrafficInfo traffic_info;
-
-  std::set<uint32_t> data_cache;
+  std::unique_ptr<PrefetchController> m_prefetch; ///< @brief per-application prefetch algorithm state
 
   std::random_device rdevice_;
   std::mt19937 rengine_;
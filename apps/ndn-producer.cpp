@@ -27,6 +27,8 @@
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
 
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
 #include <memory>
 
 NS_LOG_COMPONENT_DEFINE("ndn.Producer");
@@ -51,23 +53,30 @@ Producer::GetTypeId(void)
          "Postfix that is added to the output data (e.g., for adding producer-uniqueness)",
          StringValue("/"), MakeNameAccessor(&Producer::m_postfix), MakeNameChecker())
       .AddAttribute("PayloadSize", "Virtual payload size for Content packets", UintegerValue(1024),
-                    MakeUintegerAccessor(&Producer::m_virtualPayloadSize),
+                    MakeUintegerAccessor(&Producer::SetVirtualPayloadSize,
+                                         &Producer::GetVirtualPayloadSize),
                     MakeUintegerChecker<uint32_t>())
       .AddAttribute("Freshness", "Freshness of data packets, if 0, then unlimited freshness",
-                    TimeValue(Seconds(4)), MakeTimeAccessor(&Producer::m_freshness),
+                    TimeValue(Seconds(4)),
+                    MakeTimeAccessor(&Producer::SetFreshness, &Producer::GetFreshness),
                     MakeTimeChecker())
       .AddAttribute(
          "Signature",
          "Fake signature, 0 valid signature (default), other values application-specific",
-         UintegerValue(0), MakeUintegerAccessor(&Producer::m_signature),
+         UintegerValue(0),
+         MakeUintegerAccessor(&Producer::SetSignature, &Producer::GetSignature),
          MakeUintegerChecker<uint32_t>())
       .AddAttribute("KeyLocator",
                     "Name to be used for key locator.  If root, then key locator is not used",
-                    NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker());
+                    NameValue(),
+                    MakeNameAccessor(&Producer::SetKeyLocator, &Producer::GetKeyLocator),
+                    MakeNameChecker());
   return tid;
 }
 
 Producer::Producer()
+  : m_virtualPayloadSize(1024)
+  , m_signature(0)
 {
   NS_LOG_FUNCTION_NOARGS();
 }
@@ -91,24 +100,12 @@ Producer::StopApplication()
 }
 
 void
-Producer::OnInterest(shared_ptr<const Interest> interest)
+Producer::BuildDataTemplate()
 {
-  App::OnInterest(interest); // tracing inside
-
-  NS_LOG_FUNCTION(this << interest);
-
-  if (!m_active)
-    return;
+  Data data;
+  data.setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
-  Name dataName(interest->getName());
-  // dataName.append(m_postfix);
-  // dataName.appendVersion();
-
-  auto data = make_shared<Data>();
-  data->setName(dataName);
-  data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
-
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
+  data.setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
 
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
@@ -120,12 +117,98 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   signature.setInfo(signatureInfo);
   signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
 
-  data->setSignature(signature);
+  data.setSignature(signature);
 
-  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
+  // everything after the Name does not depend on the Interest
+  const Block& wire = data.wireEncode();
+  wire.parse();
+  const Block& nameBlock = wire.get(::ndn::tlv::Name);
+  m_dataTail = make_shared< ::ndn::Buffer>(nameBlock.end(), wire.value_end());
+}
+
+void
+Producer::SetVirtualPayloadSize(uint32_t virtualPayloadSize)
+{
+  m_virtualPayloadSize = virtualPayloadSize;
+  m_dataTail = nullptr;
+}
+
+uint32_t
+Producer::GetVirtualPayloadSize() const
+{
+  return m_virtualPayloadSize;
+}
+
+void
+Producer::SetFreshness(Time freshness)
+{
+  m_freshness = freshness;
+  m_dataTail = nullptr;
+}
+
+Time
+Producer::GetFreshness() const
+{
+  return m_freshness;
+}
+
+void
+Producer::SetSignature(uint32_t signature)
+{
+  m_signature = signature;
+  m_dataTail = nullptr;
+}
+
+uint32_t
+Producer::GetSignature() const
+{
+  return m_signature;
+}
 
-  // to create real wire encoding
-  data->wireEncode();
+void
+Producer::SetKeyLocator(Name keyLocator)
+{
+  m_keyLocator = keyLocator;
+  m_dataTail = nullptr;
+}
+
+Name
+Producer::GetKeyLocator() const
+{
+  return m_keyLocator;
+}
+
+void
+Producer::OnInterest(shared_ptr<const Interest> interest)
+{
+  App::OnInterest(interest); // tracing inside
+
+  NS_LOG_FUNCTION(this << interest);
+
+  if (!m_active)
+    return;
+
+  if (m_dataTail == nullptr) {
+    BuildDataTemplate();
+  }
+
+  // Data = [Name][pre-encoded MetaInfo, Content, SignatureInfo, SignatureValue]
+  const Block& nameBlock = interest->getName().wireEncode();
+  size_t valueLength = nameBlock.size() + m_dataTail->size();
+  size_t totalLength = ::ndn::tlv::sizeOfVarNumber(::ndn::tlv::Data)
+                       + ::ndn::tlv::sizeOfVarNumber(valueLength) + valueLength;
+
+  // exact reservation, so the Data wire is the only allocation
+  ::ndn::EncodingBuffer encoder(totalLength, 0);
+  encoder.prependByteArray(m_dataTail->data(), m_dataTail->size());
+  encoder.prependByteArray(nameBlock.wire(), nameBlock.size());
+  encoder.prependVarNumber(valueLength);
+  encoder.prependVarNumber(::ndn::tlv::Data);
+
+  auto data = make_shared<Data>();
+  data->wireDecode(encoder.block());
+
+  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
 
   m_transmittedDatas(data, this, m_face);
   m_appLink->onReceiveData(*data);
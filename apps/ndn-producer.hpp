@@ -59,6 +59,44 @@ protected:
   virtual void
   StopApplication(); // Called at time specified by Stop
 
+private:
+  /**
+   * @brief Pre-encode the part of Data that is the same for every response
+   *
+   * MetaInfo, Content (zero-filled payload of PayloadSize bytes), SignatureInfo and
+   * SignatureValue depend only on the attributes, so they are encoded once, on the first
+   * Interest after the application starts or after one of these attributes changes.  Each
+   * response then only splices the Interest name in front of this block.
+   */
+  void
+  BuildDataTemplate();
+
+  // setters of the attributes that the template depends on drop the template
+
+  void
+  SetVirtualPayloadSize(uint32_t virtualPayloadSize);
+
+  uint32_t
+  GetVirtualPayloadSize() const;
+
+  void
+  SetFreshness(Time freshness);
+
+  Time
+  GetFreshness() const;
+
+  void
+  SetSignature(uint32_t signature);
+
+  uint32_t
+  GetSignature() const;
+
+  void
+  SetKeyLocator(Name keyLocator);
+
+  Name
+  GetKeyLocator() const;
+
 private:
   Name m_prefix;
   Name m_postfix;
@@ -67,6 +105,10 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  /// @brief wire encoding of all Data elements after the Name, shared by all responses, or
+  ///        nullptr if it has to be (re)built
+  shared_ptr<const ::ndn::Buffer> m_dataTail;
 };
 
 } // namespace ndn
@@ -0,0 +1,177 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Authors:  Zhiyi Zhang: UCLA
+ *           Xin Xu: UCLA
+ *           Your name: your affiliation
+ *
+ **/
+
+#include "coverage-oracle.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/mobility-model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CoverageOracle");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(CoverageOracle);
+
+TypeId
+CoverageOracle::GetTypeId()
+{
+  static TypeId tid = TypeId("ns3::ndn::CoverageOracle")
+    .SetGroupName("Ndn")
+    .SetParent<Object>()
+    .AddConstructor<CoverageOracle>();
+  return tid;
+}
+
+CoverageOracle::CoverageOracle()
+{
+}
+
+void
+CoverageOracle::Install(const NodeContainer& aps, double range, const NodeContainer& vehicles)
+{
+  const int64_t now = Simulator::Now().GetNanoSeconds();
+  const double r2 = range * range;
+
+  for (auto vehicle = vehicles.Begin(); vehicle != vehicles.End(); vehicle++) {
+    Ptr<MobilityModel> mobility = (*vehicle)->GetObject<MobilityModel>();
+    NS_ASSERT_MSG(mobility != nullptr, "Vehicle needs a mobility model to build coverage oracle");
+
+    Vector pos = mobility->GetPosition();
+    Vector vel = mobility->GetVelocity();
+
+    Ptr<CoverageOracle> oracle = (*vehicle)->GetObject<CoverageOracle>();
+    if (oracle == nullptr) {
+      oracle = CreateObject<CoverageOracle>();
+      (*vehicle)->AggregateObject(oracle);
+    }
+
+    for (auto ap = aps.Begin(); ap != aps.End(); ap++) {
+      Ptr<MobilityModel> apMobility = (*ap)->GetObject<MobilityModel>();
+      NS_ASSERT_MSG(apMobility != nullptr, "AP needs a mobility model to build coverage oracle");
+      Vector apPos = apMobility->GetPosition();
+      Vector d(pos.x - apPos.x, pos.y - apPos.y, pos.z - apPos.z);
+
+      // |d + vel * t|^2 = range^2
+      double a = vel.x * vel.x + vel.y * vel.y + vel.z * vel.z;
+      double b = 2 * (d.x * vel.x + d.y * vel.y + d.z * vel.z);
+      double c = d.x * d.x + d.y * d.y + d.z * d.z - r2;
+
+      if (a == 0) {
+        // parked vehicle is either always or never covered by this AP
+        if (c < 0)
+          oracle->AddCoverage(now, std::numeric_limits<int64_t>::max());
+        continue;
+      }
+
+      double disc = b * b - 4 * a * c;
+      if (disc <= 0)
+        continue; // never gets into the range
+      double sq = std::sqrt(disc);
+      double enter = (-b - sq) / (2 * a);
+      double leave = (-b + sq) / (2 * a);
+      if (leave <= 0)
+        continue; // already passed this AP
+
+      oracle->AddCoverage(now + static_cast<int64_t>(std::max(enter, 0.0) * 1000000000.0),
+                          now + static_cast<int64_t>(leave * 1000000000.0));
+    }
+    oracle->Finalize();
+
+    NS_LOG_DEBUG("Node " << (*vehicle)->GetId() << " will pass " << oracle->GetNEntries() << " APs");
+  }
+}
+
+void
+CoverageOracle::AddCoverage(int64_t enterTp, int64_t handoffTp)
+{
+  NS_LOG_FUNCTION(this << enterTp << handoffTp);
+  m_entering.push_back(enterTp);
+  m_handoff.push_back(handoffTp);
+}
+
+void
+CoverageOracle::Finalize()
+{
+  std::vector<std::pair<int64_t, int64_t>> periods;
+  for (size_t i = 0; i < m_entering.size(); i++) {
+    periods.push_back(std::make_pair(m_entering[i], m_handoff[i]));
+  }
+  std::sort(periods.begin(), periods.end());
+
+  m_covered.clear();
+  for (const auto& period : periods) {
+    if (!m_covered.empty() && period.first <= m_covered.back().second) {
+      m_covered.back().second = std::max(m_covered.back().second, period.second);
+    }
+    else {
+      m_covered.push_back(period);
+    }
+  }
+
+  std::sort(m_entering.begin(), m_entering.end());
+  std::sort(m_handoff.begin(), m_handoff.end());
+}
+
+bool
+CoverageOracle::HasCoverage(int64_t tp) const
+{
+  // first period that starts after tp; the one before it is the only candidate
+  auto it = std::upper_bound(m_covered.begin(), m_covered.end(), tp,
+                             [] (int64_t value, const std::pair<int64_t, int64_t>& period) {
+                               return value < period.first;
+                             });
+  if (it == m_covered.begin())
+    return false;
+  --it;
+  return tp < it->second;
+}
+
+int64_t
+CoverageOracle::GetTimeToNextHandoff(int64_t tp) const
+{
+  size_t i = GetNextHandoffIndex(tp);
+  if (i == m_handoff.size())
+    return -1;
+  return m_handoff[i] - tp;
+}
+
+int64_t
+CoverageOracle::GetTimeToNextEntry(int64_t tp) const
+{
+  size_t i = GetNextEntryIndex(tp);
+  if (i == m_entering.size())
+    return -1;
+  return m_entering[i] - tp;
+}
+
+size_t
+CoverageOracle::GetNextEntryIndex(int64_t tp) const
+{
+  return std::upper_bound(m_entering.begin(), m_entering.end(), tp) - m_entering.begin();
+}
+
+size_t
+CoverageOracle::GetNextHandoffIndex(int64_t tp) const
+{
+  return std::upper_bound(m_handoff.begin(), m_handoff.end(), tp) - m_handoff.begin();
+}
+
+size_t
+CoverageOracle::GetNHandoffsBefore(int64_t tp) const
+{
+  return std::lower_bound(m_handoff.begin(), m_handoff.end(), tp) - m_handoff.begin();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Authors:  Zhiyi Zhang: UCLA
+ *           Xin Xu: UCLA
+ *           Your name: your affiliation
+ *
+ **/
+
+#ifndef NDNSIM_EXAMPLES_PRECACHE_STRATEGY_COVERAGE_ORACLE_HPP
+#define NDNSIM_EXAMPLES_PRECACHE_STRATEGY_COVERAGE_ORACLE_HPP
+
+#include "ns3/object.h"
+#include "ns3/node-container.h"
+
+#include <vector>
+#include <utility>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Per-vehicle schedule of AP coverage, derived from mobility at setup time
+ *
+ * The schedule is computed once by CoverageOracle::Install from the positions of the APs,
+ * their radio range and the current position/velocity of each vehicle (which is assumed to
+ * keep a constant velocity, e.g., ConstantVelocityMobilityModel).  The resulting oracle is
+ * aggregated to the vehicle node and can be obtained with `node->GetObject<CoverageOracle>()`.
+ *
+ * All time points are absolute simulation times in nanoseconds.  Entry and handoff events
+ * are kept as two sorted timelines, so the i-th entry and the i-th handoff correspond to the
+ * i-th AP along the vehicle's path.  Every query is a binary search over these timelines.
+ */
+class CoverageOracle : public Object {
+public:
+  static TypeId
+  GetTypeId();
+
+  CoverageOracle();
+
+  /**
+   * @brief Compute coverage schedules of @p vehicles and aggregate them to the vehicle nodes
+   *
+   * @param aps     AP nodes (must have a MobilityModel installed)
+   * @param range   radio range of the APs, in meters
+   * @param vehicles vehicle nodes (must have a MobilityModel installed)
+   */
+  static void
+  Install(const NodeContainer& aps, double range, const NodeContainer& vehicles);
+
+  /**
+   * @brief Add coverage period [enterTp, handoffTp) of one AP
+   *
+   * Must be followed by Finalize() before the oracle is queried.
+   */
+  void
+  AddCoverage(int64_t enterTp, int64_t handoffTp);
+
+  /**
+   * @brief Sort the event timelines and build the merged coverage intervals
+   */
+  void
+  Finalize();
+
+  /**
+   * @brief Check whether any AP covers the vehicle at @p tp
+   */
+  bool
+  HasCoverage(int64_t tp) const;
+
+  /**
+   * @brief Get time from @p tp to the next handoff, or -1 if there is none
+   */
+  int64_t
+  GetTimeToNextHandoff(int64_t tp) const;
+
+  /**
+   * @brief Get time from @p tp to the next AP entry, or -1 if there is none
+   */
+  int64_t
+  GetTimeToNextEntry(int64_t tp) const;
+
+  /**
+   * @brief Get index of the first entry strictly after @p tp (GetNEntries() if none)
+   */
+  size_t
+  GetNextEntryIndex(int64_t tp) const;
+
+  /**
+   * @brief Get index of the first handoff strictly after @p tp (GetNHandoffs() if none)
+   */
+  size_t
+  GetNextHandoffIndex(int64_t tp) const;
+
+  /**
+   * @brief Get number of handoffs that happened strictly before @p tp
+   */
+  size_t
+  GetNHandoffsBefore(int64_t tp) const;
+
+  size_t
+  GetNEntries() const
+  {
+    return m_entering.size();
+  }
+
+  size_t
+  GetNHandoffs() const
+  {
+    return m_handoff.size();
+  }
+
+  int64_t
+  GetEntry(size_t i) const
+  {
+    return m_entering[i];
+  }
+
+  int64_t
+  GetHandoff(size_t i) const
+  {
+    return m_handoff[i];
+  }
+
+private:
+  std::vector<int64_t> m_entering; ///< @brief sorted AP entry time points
+  std::vector<int64_t> m_handoff;  ///< @brief sorted AP handoff time points
+
+  /// @brief sorted, non-overlapping [start, end) periods with coverage of at least one AP
+  std::vector<std::pair<int64_t, int64_t>> m_covered;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_EXAMPLES_PRECACHE_STRATEGY_COVERAGE_ORACLE_HPP
@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Authors:  Zhiyi Zhang: UCLA
+ *           Xin Xu: UCLA
+ *           Your name: your affiliation
+ *
+ **/
+
+#include "rtt-trend-estimator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+namespace ndn {
+
+const int64_t RttTrendEstimator::NEVER = -1;
+
+RttTrendEstimator::RttTrendEstimator(size_t windowSize)
+{
+  SetWindowSize(windowSize);
+}
+
+void
+RttTrendEstimator::SetWindowSize(size_t windowSize)
+{
+  windowSize = std::max<size_t>(windowSize, 1);
+  m_samples.assign(windowSize, 0);
+  m_times.assign(windowSize, 0);
+  m_head = 0;
+  m_size = 0;
+  m_sumY = 0;
+  m_sumXY = 0;
+}
+
+void
+RttTrendEstimator::AddSample(int64_t rtt, int64_t tp)
+{
+  const size_t capacity = m_samples.size();
+
+  if (m_size < capacity) {
+    size_t pos = (m_head + m_size) % capacity;
+    m_samples[pos] = rtt;
+    m_times[pos] = tp;
+    m_size++;
+    m_sumY += rtt;
+    m_sumXY += static_cast<int64_t>(m_size) * rtt;
+    return;
+  }
+
+  // window is full: drop the oldest sample (x = 1) and shift the rest by one position
+  int64_t oldest = m_samples[m_head];
+  m_sumXY = m_sumXY - m_sumY + static_cast<int64_t>(capacity) * rtt;
+  m_sumY = m_sumY - oldest + rtt;
+
+  m_samples[m_head] = rtt;
+  m_times[m_head] = tp;
+  m_head = (m_head + 1) % capacity;
+}
+
+double
+RttTrendEstimator::GetMean() const
+{
+  if (m_size == 0)
+    return 0;
+  return static_cast<double>(m_sumY) / m_size;
+}
+
+double
+RttTrendEstimator::GetSlope() const
+{
+  if (m_size < 2)
+    return 0;
+
+  // closed forms of sum(x) and sum(x^2) for x = 1..n
+  double n = m_size;
+  double sumX = n * (n + 1) / 2;
+  double sumXX = n * (n + 1) * (2 * n + 1) / 6;
+
+  return (n * m_sumXY - sumX * m_sumY) / (n * sumXX - sumX * sumX);
+}
+
+int64_t
+RttTrendEstimator::GetPredictedTimeToThreshold(double rttThreshold) const
+{
+  if (m_size < 2)
+    return NEVER;
+
+  double slope = GetSlope();
+  double n = m_size;
+  // value of the fitted line at the newest sample (x = n)
+  double current = GetMean() + slope * (n - (n + 1) / 2);
+  if (current >= rttThreshold)
+    return 0;
+  if (slope <= 0)
+    return NEVER;
+
+  int64_t oldestTp = m_times[m_head];
+  int64_t newestTp = m_times[(m_head + m_size - 1) % m_samples.size()];
+  double interval = static_cast<double>(newestTp - oldestTp) / (m_size - 1);
+
+  return static_cast<int64_t>(std::ceil((rttThreshold - current) / slope) * interval);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Authors:  Zhiyi Zhang: UCLA
+ *           Xin Xu: UCLA
+ *           Your name: your affiliation
+ *
+ **/
+
+#ifndef NDNSIM_EXAMPLES_PRECACHE_STRATEGY_RTT_TREND_ESTIMATOR_HPP
+#define NDNSIM_EXAMPLES_PRECACHE_STRATEGY_RTT_TREND_ESTIMATOR_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Sliding-window line regression over the most recent RTT samples
+ *
+ * Samples are kept in a fixed ring buffer and x is the position of the sample in the window
+ * (1 for the oldest one).  The sums needed by ordinary least squares are updated
+ * incrementally, so adding a sample and querying the trend are O(1) regardless of the
+ * window size.  Sums are kept as integers, thus they do not drift over long runs.
+ */
+class RttTrendEstimator {
+public:
+  /// @brief GetPredictedTimeToThreshold result when the threshold is not expected to be reached
+  static const int64_t NEVER;
+
+  explicit
+  RttTrendEstimator(size_t windowSize = 5);
+
+  /**
+   * @brief Change the window size, dropping all samples
+   */
+  void
+  SetWindowSize(size_t windowSize);
+
+  size_t
+  GetWindowSize() const
+  {
+    return m_samples.size();
+  }
+
+  /**
+   * @brief Add an RTT sample (in nanoseconds) observed at time point @p tp (in nanoseconds)
+   *
+   * The oldest sample is evicted when the window is full.
+   */
+  void
+  AddSample(int64_t rtt, int64_t tp);
+
+  /**
+   * @brief Get number of samples currently in the window
+   */
+  size_t
+  GetSize() const
+  {
+    return m_size;
+  }
+
+  /**
+   * @brief Get mean of the RTT samples in the window
+   */
+  double
+  GetMean() const;
+
+  /**
+   * @brief Get slope of the fitted line, i.e., change of RTT per sample
+   *
+   * Positive slope means the RTT is growing (e.g., the station is moving away from the AP).
+   */
+  double
+  GetSlope() const;
+
+  /**
+   * @brief Predict time (in nanoseconds) until the fitted RTT reaches @p rttThreshold
+   *
+   * The number of samples until the fitted line crosses the threshold is converted to time
+   * using the mean interval between samples in the window.
+   *
+   * @return predicted time, 0 if the threshold is already reached, or NEVER if the RTT is not
+   *         growing (slope <= 0) or there are not enough samples
+   */
+  int64_t
+  GetPredictedTimeToThreshold(double rttThreshold) const;
+
+private:
+  std::vector<int64_t> m_samples; ///< @brief ring buffer of RTT samples
+  std::vector<int64_t> m_times;   ///< @brief ring buffer of sample time points
+  size_t m_head;                  ///< @brief position of the oldest sample
+  size_t m_size;                  ///< @brief number of samples in the window
+
+  int64_t m_sumY;  ///< @brief sum of y
+  int64_t m_sumXY; ///< @brief sum of x * y
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_EXAMPLES_PRECACHE_STRATEGY_RTT_TREND_ESTIMATOR_HPP
@@ -8,22 +8,10 @@
 
 #include "send-more-interest.hpp"
 #include <iostream>
+#include <algorithm>
 
 namespace ns3 {
-
-const std::vector<int64_t> entering_tp = {2 * (uint64_t)1000000000 /*40m, AP1*/,
-                                          12 * (uint64_t)1000000000 /*240m, AP2*/,
-                                          22 * (uint64_t)1000000000 /*440m, AP3*/,
-                                          32 * (uint64_t)1000000000 /*640m, AP4*/,
-                                          42 * (uint64_t)1000000000 /*840m, AP5*/,
-                                          52 * (uint64_t)1000000000/*1040m, AP6*/};
-
-const std::vector<int64_t> handoff_tp = {8 * (uint64_t)1000000000 /*160m, AP1*/,
-                                         18 * (uint64_t)1000000000 /*360m, AP2*/,
-                                         28 * (uint64_t)1000000000 /*9.833s*2, 590m, AP3*/,
-                                         38 * (uint64_t)1000000000 /*9.833s*2, 790m, AP4*/,
-                                         48 * (uint64_t)1000000000 /*16.5s*2, 990m, AP5*/,
-                                         58 * (uint64_t)1000000000 /*19.833s*2, 1190m, AP6*/};
+namespace ndn {
 
 // the time interval between two APs when there is no wifi connection
 const int64_t wifiLessInterval = 4 * (uint64_t)1000000000;
@@ -31,155 +19,112 @@ const int64_t wifiLessInterval = 4 * (uint64_t)1000000000;
 
 const int64_t not_real_coverage_period = 0.4 * (uint64_t)1000000000; /*0.08s*/
 const int64_t default_rtt = 500000000;
-static int seq_not_sent_yet_start = 0;
-static int prefetch_ap_counter = 0;
-static int recover_ap_counter = 0;
-static int stop_sending_ap_counter = 0;
 
+PrefetchController::PrefetchController()
+  : m_seqNotSentYetStart(0)
+  , m_prefetchApCounter(0)
+  , m_recoverApCounter(0)
+  , m_stopSendingApCounter(0)
+  , m_v2vPrefetchApCounter(0)
+{
+}
+
+void
+PrefetchController::SetCoverage(Ptr<CoverageOracle> coverage)
+{
+  m_coverage = coverage;
+}
 
-/**
- * @brief Use line regression to capture the trend of RTT change, thus knowing whether a station
- * is getting close to or far from the Access Point or Base Station
- *
- * @param The vector length does not need to be a fixed value
- * @return The seq(s) of packet to be sent
- */
 std::tuple<std::vector<uint32_t>, bool/*recover?*/, bool/*has coverage?*/>
-moreInterestsToSend(uint32_t seqAboutToSend, ns3::ndn::Consumer::TrafficInfo trafficInfo, int frequency)
+PrefetchController::MoreInterestsToSend(uint32_t seqAboutToSend, const Consumer::TrafficInfo& trafficInfo,
+                                        int frequency)
 {
-  uint64_t currentTp = ns3::Simulator::Now().GetNanoSeconds();
-  bool hasCoverage = true;
-  for (int i = 0; i < handoff_tp.size() - 1; i++) {
-    if (currentTp >= handoff_tp[i] && currentTp < entering_tp[i + 1] + not_real_coverage_period) {
+  const CoverageOracle& coverage = *m_coverage;
+  int64_t currentTp = ns3::Simulator::Now().GetNanoSeconds();
+  bool hasCoverage = coverage.HasCoverage(currentTp);
+  if (hasCoverage) {
+    // right after entering an AP after a period without wifi, the coverage is not real yet
+    size_t lastEntry = coverage.GetNextEntryIndex(currentTp);
+    if (lastEntry > 1 && currentTp < coverage.GetEntry(lastEntry - 1) + not_real_coverage_period &&
+        coverage.GetHandoff(lastEntry - 2) <= currentTp) {
       hasCoverage = false;
-      break;
     }
   }
-  if (currentTp <= entering_tp[0] || currentTp >= handoff_tp[handoff_tp.size() - 1]) {
-    hasCoverage = false;
-  }
 
-  // ordinary least squares of line regression
+  // mean of the line regression over the recent RTTs
   double threshold = 0;
-  if (trafficInfo.real_rtt.size() < 2) {
+  if (trafficInfo.real_rtt.GetSize() < 2) {
     threshold = default_rtt;
   }
   else {
-    double sumX = 0, sumY = 0, sumXY = 0, sumXX = 0;
-
-    int index = 1;
-    auto rttVec = trafficInfo.real_rtt;
-    auto it = rttVec.begin();
-    while (it != rttVec.end()) {
-      sumX += index;
-      sumY += *it;;
-      sumXY += index * (*it);
-      sumXX += index * index;
-      it++;
-      index++;
-    }
-
-    double aveX = sumX / rttVec.size();
-    double aveY = sumY / rttVec.size();
-    double rate = sumXY - rttVec.size() * aveX * aveY;
-    rate = rate / (sumXX - rttVec.size() * aveX * aveX);
-    threshold = aveY;
+    threshold = trafficInfo.real_rtt.GetMean();
   }
   threshold = default_rtt;
 
   // check if about to enter the next RSU, if yes, send pre-fetch Interests to front vehicle
-  for (int i = 0; i < entering_tp.size(); i++) {
-    if (prefetch_ap_counter >= i + 1) {
-      continue;
-    }
-    if (currentTp < entering_tp[i] && entering_tp[i] - currentTp <= threshold) {
-      std::vector<uint32_t> result;
-      int seqs_before_next_ap = static_cast<int>((threshold + not_real_coverage_period) / 1000000000.0 * frequency);
-      for (int i = seq_not_sent_yet_start; i <= seqAboutToSend + seqs_before_next_ap; i++) {
-        result.push_back(i);
-      }
-      prefetch_ap_counter++;
-      return std::make_tuple(result, false, hasCoverage);
+  size_t nextEntry = std::max(coverage.GetNextEntryIndex(currentTp),
+                              static_cast<size_t>(m_prefetchApCounter));
+  if (nextEntry < coverage.GetNEntries() &&
+      coverage.GetEntry(nextEntry) - currentTp <= threshold) {
+    std::vector<uint32_t> result;
+    int seqs_before_next_ap = static_cast<int>((threshold + not_real_coverage_period) / 1000000000.0 * frequency);
+    for (int i = m_seqNotSentYetStart; i <= seqAboutToSend + seqs_before_next_ap; i++) {
+      result.push_back(i);
     }
+    m_prefetchApCounter++;
+    return std::make_tuple(result, false, hasCoverage);
   }
 
-  for (int i = 0; i < handoff_tp.size(); i++) {
-    if (stop_sending_ap_counter >= i + 1) {
-      continue;
-    }
-    if (currentTp > handoff_tp[i]) {
-      seq_not_sent_yet_start = seqAboutToSend;
-      stop_sending_ap_counter++;
-    }
+  int handoffsDone = coverage.GetNHandoffsBefore(currentTp);
+  if (m_stopSendingApCounter < handoffsDone) {
+    m_seqNotSentYetStart = seqAboutToSend;
+    m_stopSendingApCounter = handoffsDone;
   }
 
   // otherwise, check if already enter the next RSU
-  for (int i = 0; i < entering_tp.size(); i++) {
-    if (recover_ap_counter >= i + 1) {
-      continue;
-    }
-    if (currentTp > entering_tp[i] + not_real_coverage_period) {
-      recover_ap_counter++;
-      return std::make_tuple(std::vector<uint32_t>(0), true, hasCoverage);
-    }
+  if (static_cast<size_t>(m_recoverApCounter) < coverage.GetNEntries() &&
+      currentTp > coverage.GetEntry(m_recoverApCounter) + not_real_coverage_period) {
+    m_recoverApCounter++;
+    return std::make_tuple(std::vector<uint32_t>(0), true, hasCoverage);
   }
   return std::make_tuple(std::vector<uint32_t>(0), false, hasCoverage);
 }
 
 std::tuple<std::vector<uint32_t>, bool>
-oneHopV2VPrefetch(uint32_t seqAboutToSend, ns3::ndn::Consumer::TrafficInfo trafficInfo, int& apCounter)
+PrefetchController::OneHopV2VPrefetch(uint32_t seqAboutToSend, const Consumer::TrafficInfo& trafficInfo)
 {
-  if (trafficInfo.real_rtt.size() < 2)
+  const CoverageOracle& coverage = *m_coverage;
+  if (trafficInfo.real_rtt.GetSize() < 2)
     return std::make_tuple(std::vector<uint32_t>(0), false);
 
-  // ordinary least squares of line regression
-  double sumX = 0;
-  double sumY = 0;
-  double sumXY = 0;
-  double sumXX = 0;
-
-  int index = 1;
-  auto rttVec = trafficInfo.real_rtt;
-  auto it = rttVec.begin();
-  while (it != rttVec.end()) {
-    sumX += index;
-    sumY += *it;;
-    sumXY += index * (*it);
-    sumXX += index * index;
-    it++;
-    index++;
-  }
-
-  double aveX = sumX / rttVec.size();
-  double aveY = sumY / rttVec.size();
-  double rate = sumXY - rttVec.size() * aveX * aveY;
-  rate = rate / (sumXX - rttVec.size() * aveX * aveX);
+  // line regression over the recent RTTs
+  double aveY = trafficInfo.real_rtt.GetMean();
 
   // new algorithm under new assumption
   // before leaving
-  uint64_t currentTp = ns3::Simulator::Now().GetNanoSeconds();
+  int64_t currentTp = ns3::Simulator::Now().GetNanoSeconds();
   double threshold = aveY;
-  for (int i = 0; i < handoff_tp.size(); i++) {
-    if (handoff_tp[i] > currentTp && handoff_tp[i] - currentTp <= threshold) {
-      if (apCounter >= i + 1) {
-        // already prefetch for this AP
-        break;
-      }
-
+  size_t nextHandoff = coverage.GetNextHandoffIndex(currentTp);
+  if (nextHandoff < coverage.GetNHandoffs() &&
+      coverage.GetHandoff(nextHandoff) - currentTp <= threshold) {
+    if (m_v2vPrefetchApCounter < static_cast<int>(nextHandoff) + 1) {
       std::vector<uint32_t> result;
       int insideNumber = static_cast<int>(threshold / 100000000);
       int outsideNumber = static_cast<int>(wifiLessInterval / 100000000);
       for (int j = 0; j < insideNumber + outsideNumber + 1; j++) {
         result.push_back(seqAboutToSend + j);
       }
-      apCounter++;
+      m_v2vPrefetchApCounter++;
       return std::make_tuple(result, false);
     }
+    // otherwise, already prefetch for this AP
   }
 
   // after arriving
-  for (int i = 0; i < entering_tp.size(); i++) {
-    if (currentTp > entering_tp[i] && currentTp - entering_tp[i] <= not_real_coverage_period) {
+  size_t nextEntry = coverage.GetNextEntryIndex(currentTp);
+  if (nextEntry > 0) {
+    int64_t lastEntry = coverage.GetEntry(nextEntry - 1);
+    if (currentTp > lastEntry && currentTp - lastEntry <= not_real_coverage_period) {
       return std::make_tuple(std::vector<uint32_t>(0), true);
     }
   }
@@ -192,4 +137,5 @@ oneHopV2VPrefetch(uint32_t seqAboutToSend, ns3::ndn::Consumer::TrafficInfo traff
 //   return std::vector<uint32_t>(0);
 // }
 
+} // namespace ndn
 } // namespace ns3
@@ -10,18 +10,57 @@
 #define NDNSIM_EXAMPLES_PRECACHE_STRATEGY_SEND_MORE_INTEREST_HPP
 
 #include "../ndn-consumer.hpp"
+#include "coverage-oracle.hpp"
 #include <vector>
 
 namespace ns3 {
+namespace ndn {
 
-std::tuple<std::vector<uint32_t>, bool, bool>
-moreInterestsToSend(uint32_t seqJustSent, ns3::ndn::Consumer::TrafficInfo trafficInfo, int frequency);
+/**
+ * @brief State of the prefetch algorithm of one consumer application
+ *
+ * Each Consumer owns its own controller, so any number of downloading vehicles can run
+ * in the same simulation.
+ */
+class PrefetchController {
+public:
+  PrefetchController();
+
+  /**
+   * @brief Set AP coverage schedule of the vehicle the consumer is running on
+   */
+  void
+  SetCoverage(Ptr<CoverageOracle> coverage);
+
+  /**
+   * @brief Use line regression to capture the trend of RTT change, thus knowing whether a station
+   * is getting close to or far from the Access Point or Base Station
+   *
+   * @return The seq(s) of packet to be sent, whether to recover and whether there is coverage
+   */
+  std::tuple<std::vector<uint32_t>, bool, bool>
+  MoreInterestsToSend(uint32_t seqAboutToSend, const Consumer::TrafficInfo& trafficInfo, int frequency);
 
-std::tuple<std::vector<uint32_t>, bool>
-oneHopV2VPrefetch(uint32_t seqJustSent, ns3::ndn::Consumer::TrafficInfo trafficInfo, int& apCounter);
+  /**
+   * @brief Decide which seq(s) to prefetch through one-hop V2V communication before leaving an AP
+   */
+  std::tuple<std::vector<uint32_t>, bool>
+  OneHopV2VPrefetch(uint32_t seqAboutToSend, const Consumer::TrafficInfo& trafficInfo);
+
+private:
+  Ptr<CoverageOracle> m_coverage;
+
+  int m_seqNotSentYetStart;
+  int m_prefetchApCounter;
+  int m_recoverApCounter;
+  int m_stopSendingApCounter;
+  int m_v2vPrefetchApCounter;
+};
 
 // std::vector<uint32_t>
 // MultiHopV2VPrefetch(uint32_t seqJustSent, ns3::ndn::Consumer::TrafficInfo trafficInfo);
 
-}
+} // namespace ndn
+} // namespace ns3
+
 #endif // NDNSIM_EXAMPLES_PRECACHE_STRATEGY_SEND_MORE_INTEREST_HPP
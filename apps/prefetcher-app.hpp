@@ -31,6 +31,10 @@ public:
 
 Address
 GetCurrentAP() {
+  Ptr<ndn::WifiAssociation> association = GetNode()->GetObject<ndn::WifiAssociation>();
+  if (association != nullptr) {
+    return association->GetBssid();
+  }
   Ptr<WifiNetDevice> wifiDev = GetNode()->GetDevice(0)->GetObject<WifiNetDevice>();
   assert(wifiDev != nullptr);
   Ptr<StaWifiMac> staMac = wifiDev->GetMac()->GetObject<StaWifiMac>();
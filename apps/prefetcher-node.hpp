@@ -27,6 +27,9 @@
 #include "ns3/wifi-net-device.h"
 #include "ns3/sta-wifi-mac.h"
 
+#include "ns3/ndnSIM/model/cs/speculative-requests.hpp"
+#include "ns3/ndnSIM/model/ndn-wifi-association.hpp"
+
 namespace ndn {
 
 NS_LOG_COMPONENT_DEFINE("ndn.Prefetcher");
@@ -84,16 +87,28 @@ class PrefetcherNode {
     std::string cur_ap = os.str().c_str();
     std::cout << "node(" << nid_ << "), last ap = " << last_ap << ", current ap = " << cur_ap << std::endl;
 
+    // the Data is meant to be picked up at the current AP, so only its store (if it has
+    // prefetch classes) learns that the segments are speculative
+    ns3::ndn::cs::SpeculativeRequests* requests = nullptr;
+    ns3::Ptr<ns3::WifiNetDevice> ap =
+      ns3::ndn::WifiAssociation::FindAp(ns3::Mac48Address::ConvertFrom(cur_ap_addr));
+    if (ap != nullptr) {
+      requests = ns3::ndn::cs::SpeculativeRequests::Get(ap->GetNode());
+    }
+
     for (int seq = seq2; seq < seq1 + 1; seq++) {
       if (rand() % 100 < m_chance) {
-        SendInterest(seq);
+        SendInterest(seq, requests);
       }
     }
   }
 
-  void SendInterest(uint32_t seq) {
+  void SendInterest(uint32_t seq, ns3::ndn::cs::SpeculativeRequests* requests) {
     auto real_interest_name = Name(prefix_).append(std::to_string(seq)).appendSequenceNumber(seq);
     Interest preInterest(real_interest_name, kInterestLifetime);
+    if (requests != nullptr) {
+      requests->Register(real_interest_name, ns3::MilliSeconds(kInterestLifetime.count()));
+    }
     face_.expressInterest(preInterest, std::bind(&PrefetcherNode::OnRemoteData, this, _2),
                           [](const Interest&, const lp::Nack&) {},
                           [](const Interest&) {});
@@ -208,6 +208,13 @@ int main (int argc, char *argv[])
     nxt += 20;
   }
 
+  ////// Derive the AP coverage schedule of each vehicle from the mobility setup
+  NodeContainer aps;
+  for (int i = 0; i < bottomrow; i++) {
+    aps.Add(wifiApNodes[i]);
+  }
+  ndn::CoverageOracle::Install(aps, range, consumers);
+
   // std::cout << "position: " << cvmm->GetPosition() << " velocity: " << cvmm->GetVelocity() << std::endl;
   // std::cout << "mover mobility model: " << mobile.GetMobilityModelType() << std::endl; // just for confirmation
 
@@ -276,8 +283,13 @@ int main (int argc, char *argv[])
     prefetcherHelper.Install(consumers.Get(i)).Start(Seconds(0.1));
   }
 
+  // the uplink route exists only while a vehicle is associated, Interests sent between two APs
+  // get a NoRoute Nack and are retransmitted by the consumer when they time out
+  ndn::MobilityRoutingHelper mobilityRouting;
+  mobilityRouting.AddUplinkPrefix("/youtube/video001", std::numeric_limits<int32_t>::max());
+  mobilityRouting.Install(consumers);
+
   for (auto consumer: consumers) {
-    ndn::FibHelper::AddRouteForDevice(consumer, "/youtube/video001", std::numeric_limits<int32_t>::max(), 0);
     ndn::FibHelper::AddRouteForDevice(consumer, "/prefetch", std::numeric_limits<int32_t>::max(), 1);
   }
 
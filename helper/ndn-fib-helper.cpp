@@ -39,6 +39,8 @@
 #include "ns3/data-rate.h"
 
 #include "daemon/mgmt/fib-manager.hpp"
+#include "daemon/fw/forwarder.hpp"
+#include "daemon/table/fib.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 
@@ -81,6 +83,45 @@ FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
   l3protocol->injectInterest(*command);
 }
 
+void
+FibHelper::AddRoutesDirect(Ptr<Node> node, const std::vector<Route>& routes)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  nfd::Fib& fib = ndn->getForwarder()->getFib();
+  for (const auto& route : routes) {
+    NS_LOG_LOGIC("[" << node->GetId() << "]$ route add " << route.prefix << " via "
+                     << route.face->getLocalUri() << " metric " << route.metric);
+
+    // same as FibManager::addNextHop
+    nfd::fib::Entry* entry = fib.insert(route.prefix).first;
+    entry->addNextHop(*route.face, static_cast<uint64_t>(route.metric));
+  }
+}
+
+void
+FibHelper::RemoveRoutesDirect(Ptr<Node> node, const std::vector<Route>& routes)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  nfd::Fib& fib = ndn->getForwarder()->getFib();
+  for (const auto& route : routes) {
+    NS_LOG_LOGIC("[" << node->GetId() << "]$ route del " << route.prefix << " via "
+                     << route.face->getLocalUri());
+
+    // same as FibManager::removeNextHop
+    nfd::fib::Entry* entry = fib.findExactMatch(route.prefix);
+    if (entry == nullptr)
+      continue;
+    entry->removeNextHop(*route.face);
+    if (!entry->hasNextHops()) {
+      fib.erase(*entry);
+    }
+  }
+}
+
 void
 FibHelper::AddRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, int32_t metric)
 {
@@ -28,6 +28,8 @@
 
 #include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
 
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 
@@ -43,6 +45,42 @@ using ::ndn::nfd::ControlParameters;
  */
 class FibHelper {
 public:
+  /**
+   * @brief Next hop to be installed by AddRoutesDirect or removed by RemoveRoutesDirect
+   */
+  struct Route
+  {
+    Name prefix;
+    shared_ptr<Face> face;
+    int32_t metric;
+  };
+
+  /**
+   * @brief Add forwarding entries straight into the FIB of @p node
+   *
+   * Unlike AddRoute, which builds, signs and injects a FIB management command for every
+   * next hop, the next hops are written directly into the forwarder's FIB, with the same
+   * effect as the add-nexthop command.  Meant for installing large numbers of routes, e.g.,
+   * by routing helpers.
+   *
+   * \param node   Node
+   * \param routes Next hops to add
+   */
+  static void
+  AddRoutesDirect(Ptr<Node> node, const std::vector<Route>& routes);
+
+  /**
+   * @brief Remove forwarding entries straight from the FIB of @p node
+   *
+   * Counterpart of AddRoutesDirect with the same effect as the remove-nexthop command; the
+   * metric of @p routes is ignored.
+   *
+   * \param node   Node
+   * \param routes Next hops to remove
+   */
+  static void
+  RemoveRoutesDirect(Ptr<Node> node, const std::vector<Route>& routes);
+
   /**
    * \brief Add forwarding entry to FIB
    *
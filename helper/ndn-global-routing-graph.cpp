@@ -0,0 +1,481 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-global-routing-graph.hpp"
+
+#include "ns3/node-list.h"
+#include "ns3/channel-list.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+
+NS_LOG_COMPONENT_DEFINE("ndn.GlobalRouterGraph");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+const uint32_t NOT_QUEUED = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief Minimum number of searches per worker thread; fewer are not worth a thread
+ */
+const size_t MIN_SEARCHES_PER_THREAD = 8;
+
+} // namespace
+
+const uint32_t GlobalRouterGraph::NO_FACE;
+const uint32_t GlobalRouterGraph::NO_VERTEX;
+const uint32_t GlobalRouterGraph::NO_EDGE;
+const uint32_t GlobalRouterGraph::INFINITE_DISTANCE;
+
+GlobalRouterGraph::GlobalRouterGraph()
+{
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+    if (gr != 0)
+      m_routers.push_back(gr);
+  }
+  m_nNodes = m_routers.size();
+
+  for (ChannelList::Iterator channel = ChannelList::Begin(); channel != ChannelList::End();
+       channel++) {
+    Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter>();
+    if (gr != 0)
+      m_routers.push_back(gr);
+  }
+
+  std::unordered_map<const GlobalRouter*, uint32_t> vertices;
+  for (uint32_t v = 0; v < m_routers.size(); v++) {
+    vertices[PeekPointer(m_routers[v])] = v;
+  }
+
+  m_offsets.reserve(m_routers.size() + 1);
+  for (uint32_t v = 0; v < m_routers.size(); v++) {
+    const auto& gr = m_routers[v];
+    m_offsets.push_back(m_targets.size());
+
+    for (const auto& incidency : gr->GetIncidencies()) {
+      auto target = vertices.find(PeekPointer(std::get<2>(incidency)));
+      if (target == vertices.end()) {
+        NS_LOG_DEBUG("Skipping edge to GlobalRouter not installed on any node or channel");
+        continue;
+      }
+      m_targets.push_back(target->second);
+      m_edgeSources.push_back(v);
+
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      if (face == nullptr) {
+        m_metrics.push_back(0);
+        m_edgeFaces.push_back(NO_FACE);
+        continue;
+      }
+
+      // GlobalRoutingHelper adds a single incidency per face
+      auto index = m_faceIndices.insert(std::make_pair(face.get(), m_faces.size()));
+      if (index.second) {
+        m_faces.push_back(face);
+        m_faceEdges.push_back(m_targets.size() - 1);
+        m_faceMetrics.push_back(static_cast<uint16_t>(face->getMetric()));
+      }
+      m_metrics.push_back(m_faceMetrics[index.first->second]);
+      m_edgeFaces.push_back(index.first->second);
+    }
+  }
+  m_offsets.push_back(m_targets.size());
+
+  // counting sort of edges by their target
+  m_reverseOffsets.assign(m_routers.size() + 1, 0);
+  for (uint32_t target : m_targets) {
+    m_reverseOffsets[target + 1]++;
+  }
+  for (size_t v = 0; v < m_routers.size(); v++) {
+    m_reverseOffsets[v + 1] += m_reverseOffsets[v];
+  }
+  m_reverseEdges.resize(m_targets.size());
+  std::vector<uint32_t> fill(m_reverseOffsets.begin(), m_reverseOffsets.end() - 1);
+  for (uint32_t e = 0; e < m_targets.size(); e++) {
+    m_reverseEdges[fill[m_targets[e]]++] = e;
+  }
+
+  NS_LOG_DEBUG("Snapshot of " << m_nNodes << " nodes, " << m_routers.size() - m_nNodes
+               << " channels and " << m_targets.size() << " edges");
+}
+
+void
+GlobalRouterGraph::ShortestPaths(uint32_t source, Search& search) const
+{
+  this->search(source, false, search);
+}
+
+void
+GlobalRouterGraph::ReverseShortestPaths(uint32_t target, Search& search) const
+{
+  this->search(target, true, search);
+}
+
+void
+GlobalRouterGraph::search(uint32_t root, bool isReverse, Search& search) const
+{
+  search.reset(m_routers.size());
+  search.distance[root] = 0;
+  search.push(root);
+
+  propagate(isReverse, search);
+}
+
+void
+GlobalRouterGraph::propagate(bool isReverse, Search& search) const
+{
+  const auto& offsets = isReverse ? m_reverseOffsets : m_offsets;
+  while (!search.m_heap.empty()) {
+    uint32_t u = search.pop();
+    uint32_t distance = search.distance[u];
+
+    for (uint32_t i = offsets[u]; i < offsets[u + 1]; i++) {
+      uint32_t e = isReverse ? m_reverseEdges[i] : i;
+      uint32_t v = isReverse ? m_edgeSources[e] : m_targets[e];
+      uint32_t newDistance = distance + m_metrics[e];
+      if (newDistance >= search.distance[v])
+        continue;
+
+      search.distance[v] = newDistance;
+      search.parent[v] = u;
+      search.parentEdge[v] = e;
+      if (isReverse) {
+        search.firstHop[v] = m_edgeFaces[e];
+      }
+      else {
+        // the first face along the path; edges leaving channels have none
+        search.firstHop[v] = search.firstHop[u] != NO_FACE ? search.firstHop[u] : m_edgeFaces[e];
+      }
+      search.push(v);
+    }
+  }
+}
+
+bool
+GlobalRouterGraph::repair(uint32_t source, uint32_t edge, Search& search) const
+{
+  uint32_t from = m_edgeSources[edge];
+  uint32_t to = m_targets[edge];
+
+  search.m_heap.clear();
+  search.m_position.assign(m_routers.size(), NOT_QUEUED);
+  search.m_order.clear();
+
+  if (search.parentEdge[to] != edge) {
+    // only vertices that become closer through the edge are affected
+    if (search.distance[from] >= INFINITE_DISTANCE
+        || search.distance[from] + m_metrics[edge] >= search.distance[to])
+      return false;
+
+    search.distance[to] = search.distance[from] + m_metrics[edge];
+    search.parent[to] = from;
+    search.parentEdge[to] = edge;
+    search.firstHop[to] = search.firstHop[from] != NO_FACE ? search.firstHop[from] :
+                                                             m_edgeFaces[edge];
+    search.push(to);
+    propagate(false, search);
+    return true;
+  }
+
+  // The edge is on the tree, so paths to `to` and everything below it have to be found again.
+  // Find the subtree by following parents, remembering the answer for every vertex on the way.
+  enum : uint8_t { UNKNOWN, INSIDE, OUTSIDE };
+  std::vector<uint8_t> state(m_routers.size(), UNKNOWN);
+  state[source] = OUTSIDE;
+  state[to] = INSIDE;
+
+  std::vector<uint32_t> subtree;
+  std::vector<uint32_t> path;
+  for (uint32_t v = 0; v < m_routers.size(); v++) {
+    uint32_t u = v;
+    while (state[u] == UNKNOWN) {
+      if (search.parent[u] == NO_VERTEX) {
+        state[u] = OUTSIDE; // not reached
+        break;
+      }
+      path.push_back(u);
+      u = search.parent[u];
+    }
+    for (uint32_t w : path) {
+      state[w] = state[u];
+    }
+    path.clear();
+
+    if (state[v] == INSIDE)
+      subtree.push_back(v);
+  }
+
+  for (uint32_t v : subtree) {
+    search.distance[v] = INFINITE_DISTANCE;
+    search.firstHop[v] = NO_FACE;
+    search.parent[v] = NO_VERTEX;
+    search.parentEdge[v] = NO_EDGE;
+  }
+
+  // start from the best way into the subtree for each of its vertices, then continue as usual
+  for (uint32_t v : subtree) {
+    for (uint32_t i = m_reverseOffsets[v]; i < m_reverseOffsets[v + 1]; i++) {
+      uint32_t e = m_reverseEdges[i];
+      uint32_t u = m_edgeSources[e];
+      if (state[u] == INSIDE || search.distance[u] + m_metrics[e] >= search.distance[v])
+        continue;
+
+      search.distance[v] = search.distance[u] + m_metrics[e];
+      search.parent[v] = u;
+      search.parentEdge[v] = e;
+      search.firstHop[v] = search.firstHop[u] != NO_FACE ? search.firstHop[u] : m_edgeFaces[e];
+    }
+    if (search.distance[v] < INFINITE_DISTANCE)
+      search.push(v);
+  }
+  propagate(false, search);
+  return true;
+}
+
+void
+GlobalRouterGraph::RepairShortestPathsFrom(
+  const std::vector<uint32_t>& sources, uint32_t edge, std::vector<Search>& searches,
+  const std::function<void(size_t, const Search&)>& visit) const
+{
+  forEachSearch(sources.size(), [&] (size_t i, Search&) {
+      if (repair(sources[i], edge, searches[i]))
+        visit(i, searches[i]);
+    });
+}
+
+uint32_t
+GlobalRouterGraph::SetFaceUp(const Face& face, bool isUp)
+{
+  auto index = m_faceIndices.find(&face);
+  if (index == m_faceIndices.end())
+    return NO_EDGE;
+
+  uint32_t edge = m_faceEdges[index->second];
+  uint16_t metric = isUp ? m_faceMetrics[index->second] : INFINITE_DISTANCE;
+  if (m_metrics[edge] == metric)
+    return NO_EDGE;
+
+  m_metrics[edge] = metric;
+  return edge;
+}
+
+void
+GlobalRouterGraph::ShortestPathsFrom(const std::vector<uint32_t>& sources,
+                                     const std::function<void(size_t, const Search&)>& visit) const
+{
+  forEachSearch(sources.size(), [&] (size_t i, Search& search) {
+      ShortestPaths(sources[i], search);
+      visit(i, search);
+    });
+}
+
+void
+GlobalRouterGraph::ShortestPathsTo(const std::vector<uint32_t>& targets,
+                                   const std::function<void(size_t, Search&)>& visit) const
+{
+  forEachSearch(targets.size(), [&] (size_t i, Search& search) {
+      ReverseShortestPaths(targets[i], search);
+      visit(i, search);
+    });
+}
+
+void
+GlobalRouterGraph::forEachSearch(size_t nSearches,
+                                 const std::function<void(size_t, Search&)>& run) const
+{
+  std::atomic<size_t> next(0);
+  auto worker = [&] {
+    Search search;
+    for (size_t i = next++; i < nSearches; i = next++) {
+      run(i, search);
+    }
+  };
+
+  size_t nThreads = std::max(1u, std::thread::hardware_concurrency());
+  nThreads = std::min(nThreads,
+                      (nSearches + MIN_SEARCHES_PER_THREAD - 1) / MIN_SEARCHES_PER_THREAD);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < nThreads; t++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+void
+GlobalRouterGraph::DetourDistances(const Search& search, uint32_t via,
+                                   std::vector<uint32_t>& detours) const
+{
+  uint32_t base = search.m_enter[via];
+  uint32_t size = search.m_leave[via] - base;
+  detours.assign(size, INFINITE_DISTANCE);
+
+  typedef std::pair<uint32_t, uint32_t> Entry; // distance, subtree index
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+  // leave the subtree through an edge to any vertex outside, whose own path avoids `via`
+  for (uint32_t i = 1; i < size; i++) {
+    uint32_t u = search.m_preorder[base + i];
+    for (uint32_t e = m_offsets[u]; e < m_offsets[u + 1]; e++) {
+      uint32_t v = m_targets[e];
+      if (search.IsOnTreePath(via, v) || search.distance[v] >= INFINITE_DISTANCE)
+        continue;
+      detours[i] = std::min<uint32_t>(detours[i], m_metrics[e] + search.distance[v]);
+    }
+    if (detours[i] < INFINITE_DISTANCE)
+      queue.push(Entry(detours[i], i));
+  }
+
+  // and get to such an exit within the subtree, not passing `via` itself
+  while (!queue.empty()) {
+    Entry entry = queue.top();
+    queue.pop();
+    if (entry.first > detours[entry.second])
+      continue; // stale
+
+    uint32_t v = search.m_preorder[base + entry.second];
+    for (uint32_t r = m_reverseOffsets[v]; r < m_reverseOffsets[v + 1]; r++) {
+      uint32_t e = m_reverseEdges[r];
+      uint32_t u = m_edgeSources[e];
+      if (u == via || !search.IsOnTreePath(via, u))
+        continue;
+
+      uint32_t i = search.GetSubtreeIndex(via, u);
+      uint32_t distance = entry.first + m_metrics[e];
+      if (distance < detours[i]) {
+        detours[i] = distance;
+        queue.push(Entry(distance, i));
+      }
+    }
+  }
+}
+
+void
+GlobalRouterGraph::Search::reset(size_t nVertices)
+{
+  distance.assign(nVertices, INFINITE_DISTANCE);
+  firstHop.assign(nVertices, NO_FACE);
+  parent.assign(nVertices, NO_VERTEX);
+  parentEdge.assign(nVertices, NO_EDGE);
+  m_position.assign(nVertices, NOT_QUEUED);
+  m_heap.clear();
+  m_order.clear();
+}
+
+void
+GlobalRouterGraph::Search::IndexTree()
+{
+  // parents are settled before their children, so subtree sizes can be summed up in reverse
+  // settle order, and preorder ranges handed out in settle order
+  m_enter.assign(distance.size(), NOT_QUEUED);
+  m_leave.assign(distance.size(), 0);
+  for (auto v = m_order.rbegin(); v != m_order.rend(); v++) {
+    m_leave[*v]++;
+    if (parent[*v] != NO_VERTEX)
+      m_leave[parent[*v]] += m_leave[*v];
+  }
+
+  m_preorder.resize(m_order.size());
+
+  // m_position is free after the search; reuse it for the next free preorder number
+  for (uint32_t v : m_order) {
+    uint32_t size = m_leave[v];
+    if (parent[v] == NO_VERTEX) {
+      m_enter[v] = 0;
+    }
+    else {
+      m_enter[v] = m_position[parent[v]];
+      m_position[parent[v]] += size;
+    }
+    m_leave[v] = m_enter[v] + size;
+    m_position[v] = m_enter[v] + 1;
+    m_preorder[m_enter[v]] = v;
+  }
+}
+
+void
+GlobalRouterGraph::Search::push(uint32_t vertex)
+{
+  if (m_position[vertex] == NOT_QUEUED) {
+    m_position[vertex] = m_heap.size();
+    m_heap.push_back(vertex);
+  }
+  // otherwise the distance has decreased and the vertex may need to move up
+  siftUp(m_position[vertex]);
+}
+
+void
+GlobalRouterGraph::Search::siftUp(size_t i)
+{
+  uint32_t vertex = m_heap[i];
+  while (i > 0) {
+    size_t parent = (i - 1) / 2;
+    if (distance[m_heap[parent]] <= distance[vertex])
+      break;
+    m_heap[i] = m_heap[parent];
+    m_position[m_heap[i]] = i;
+    i = parent;
+  }
+  m_heap[i] = vertex;
+  m_position[vertex] = i;
+}
+
+uint32_t
+GlobalRouterGraph::Search::pop()
+{
+  uint32_t top = m_heap.front();
+  uint32_t vertex = m_heap.back();
+  m_heap.pop_back();
+  m_order.push_back(top);
+
+  // with non-negative metrics a popped vertex is final, so it does not need to be marked
+  size_t size = m_heap.size();
+  if (size > 0) {
+    size_t i = 0;
+    while (true) {
+      size_t child = 2 * i + 1;
+      if (child >= size)
+        break;
+      if (child + 1 < size && distance[m_heap[child + 1]] < distance[m_heap[child]])
+        child++;
+      if (distance[vertex] <= distance[m_heap[child]])
+        break;
+      m_heap[i] = m_heap[child];
+      m_position[m_heap[i]] = i;
+      i = child;
+    }
+    m_heap[i] = vertex;
+    m_position[vertex] = i;
+  }
+  return top;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,322 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_HELPER_NDN_GLOBAL_ROUTING_GRAPH_HPP
+#define NDNSIM_HELPER_NDN_GLOBAL_ROUTING_GRAPH_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-global-router.hpp"
+
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Snapshot of the GlobalRouter graph in compressed sparse row form
+ *
+ * Vertices are the GlobalRouter objects of all nodes (ids 0..GetNNodes()-1, in NodeList order)
+ * followed by those of all channels (in ChannelList order).  Out-edges of vertex v are stored
+ * contiguously in flat arrays, each edge with its target vertex, its metric and the index of its
+ * face (NO_FACE for edges leaving a channel, which cost nothing).
+ *
+ * Incoming edges are indexed as well, so searches can run either from a source towards all
+ * vertices or from all vertices towards a target.
+ *
+ * Face metrics are copied when the snapshot is taken, so searches never touch faces or
+ * GlobalRouter objects and can run concurrently from worker threads.  Faces can later be marked
+ * down or up again (SetFaceUp), and existing searches repaired for the change.
+ */
+class GlobalRouterGraph {
+public:
+  static const uint32_t NO_FACE = std::numeric_limits<uint32_t>::max();
+  static const uint32_t NO_VERTEX = std::numeric_limits<uint32_t>::max();
+  static const uint32_t NO_EDGE = std::numeric_limits<uint32_t>::max();
+
+  /**
+   * @brief Distance of unreachable vertices
+   *
+   * Paths of this or larger cost are treated as unreachable, same as by the BGL-based search
+   * this snapshot replaces.
+   */
+  static const uint32_t INFINITE_DISTANCE = std::numeric_limits<uint16_t>::max();
+
+  /**
+   * @brief Result of a single-source search, reusable between searches to avoid allocations
+   */
+  class Search {
+  public:
+    /**
+     * @brief Distance of each vertex from the source (to the target for reverse searches)
+     */
+    std::vector<uint32_t> distance;
+
+    /**
+     * @brief Face index of the first hop from the source towards each vertex
+     *
+     * For reverse searches, face index of the first hop from each vertex towards the target.
+     */
+    std::vector<uint32_t> firstHop;
+
+    /**
+     * @brief Parent of each vertex in the search tree, NO_VERTEX for the root and unreached ones
+     *
+     * For reverse searches, the parent is the next vertex on the path towards the target.
+     */
+    std::vector<uint32_t> parent;
+
+    /**
+     * @brief Edge from (to, for reverse searches) the parent of each vertex, or NO_EDGE
+     */
+    std::vector<uint32_t> parentEdge;
+
+    /**
+     * @brief Number the search tree so that IsOnTreePath works in constant time
+     */
+    void
+    IndexTree();
+
+    /**
+     * @brief Check whether the tree path between @p vertex and the root passes through @p via
+     *
+     * A vertex is on its own tree path.  Requires IndexTree() after the search.
+     */
+    bool
+    IsOnTreePath(uint32_t via, uint32_t vertex) const
+    {
+      return m_enter[via] <= m_enter[vertex] && m_enter[vertex] < m_leave[via];
+    }
+
+    /**
+     * @brief Get index of @p vertex among the vertices whose tree path passes through @p via
+     *
+     * The index of @p via itself is 0.  Requires IsOnTreePath(via, vertex).
+     */
+    uint32_t
+    GetSubtreeIndex(uint32_t via, uint32_t vertex) const
+    {
+      return m_enter[vertex] - m_enter[via];
+    }
+
+  private:
+    void
+    reset(size_t nVertices);
+
+    void
+    push(uint32_t vertex);
+
+    void
+    siftUp(size_t i);
+
+    uint32_t
+    pop();
+
+  private:
+    std::vector<uint32_t> m_heap;     ///< @brief binary min-heap of vertices, keyed by distance
+    std::vector<uint32_t> m_position; ///< @brief position of each vertex in the heap
+    std::vector<uint32_t> m_order;    ///< @brief vertices in the order they were settled
+
+    std::vector<uint32_t> m_enter; ///< @brief preorder number of each vertex in the search tree
+    std::vector<uint32_t> m_leave; ///< @brief end of the preorder range of each vertex's subtree
+    std::vector<uint32_t> m_preorder; ///< @brief reached vertices by preorder number
+
+    friend class GlobalRouterGraph;
+  };
+
+  /**
+   * @brief Take a snapshot of all GlobalRouter objects installed on nodes and channels
+   */
+  GlobalRouterGraph();
+
+  size_t
+  GetNVertices() const
+  {
+    return m_routers.size();
+  }
+
+  /**
+   * @brief Get number of vertices that belong to nodes
+   */
+  size_t
+  GetNNodes() const
+  {
+    return m_nNodes;
+  }
+
+  Ptr<GlobalRouter>
+  GetRouter(uint32_t vertex) const
+  {
+    return m_routers[vertex];
+  }
+
+  const shared_ptr<Face>&
+  GetFace(uint32_t faceIndex) const
+  {
+    return m_faces[faceIndex];
+  }
+
+  /**
+   * @brief Find shortest paths from @p source to all vertices
+   *
+   * A vertex is reachable if its distance is below INFINITE_DISTANCE and its first hop is not
+   * NO_FACE.  Distances are compared by metric only; among equal-cost paths the one found first
+   * is kept.
+   */
+  void
+  ShortestPaths(uint32_t source, Search& search) const;
+
+  /**
+   * @brief Find shortest paths from all vertices to @p target, following edges backwards
+   */
+  void
+  ReverseShortestPaths(uint32_t target, Search& search) const;
+
+  /**
+   * @brief Run ShortestPaths from each of @p sources, spread over worker threads
+   *
+   * @p visit is called once per source from the thread that ran its search, with the index of
+   * the source in @p sources.  It must only write state owned by that source.
+   */
+  void
+  ShortestPathsFrom(const std::vector<uint32_t>& sources,
+                    const std::function<void(size_t, const Search&)>& visit) const;
+
+  /**
+   * @brief Run ReverseShortestPaths to each of @p targets, spread over worker threads
+   *
+   * @p visit is called the same way as by ShortestPathsFrom.  The search passed to it is not
+   * const, so that @p visit can call Search::IndexTree().
+   */
+  void
+  ShortestPathsTo(const std::vector<uint32_t>& targets,
+                  const std::function<void(size_t, Search&)>& visit) const;
+
+  /**
+   * @brief Update searches @p searches from @p sources after the metric of @p edge changed
+   *
+   * Only searches whose shortest paths are affected are repaired, and only the affected part of
+   * each: the subtree below @p edge if it was a tree edge, or the vertices that get closer
+   * through @p edge otherwise.  Repairs are spread over worker threads, and @p visit is called
+   * from them for every repaired search.  Search::IndexTree() results are not valid after a
+   * repair.
+   */
+  void
+  RepairShortestPathsFrom(const std::vector<uint32_t>& sources, uint32_t edge,
+                          std::vector<Search>& searches,
+                          const std::function<void(size_t, const Search&)>& visit) const;
+
+  /**
+   * @brief Mark @p face down (its edge becomes unusable) or up (its metric is restored)
+   *
+   * @return the edge of @p face if its status has changed, otherwise NO_EDGE
+   */
+  uint32_t
+  SetFaceUp(const Face& face, bool isUp);
+
+  /**
+   * @brief Find distances to the target of reverse search @p search over paths avoiding @p via
+   *
+   * Only vertices whose tree path passes through @p via have to take a detour; the distances of
+   * all others stay the same.  Requires Search::IndexTree().
+   *
+   * @param[out] detours distances of the vertices whose tree path passes through @p via, indexed
+   *                     by Search::GetSubtreeIndex (@p via itself is INFINITE_DISTANCE)
+   */
+  void
+  DetourDistances(const Search& search, uint32_t via, std::vector<uint32_t>& detours) const;
+
+  /**
+   * @brief Get out-edges of @p vertex as a range of edge indices
+   */
+  std::pair<uint32_t, uint32_t>
+  GetOutEdges(uint32_t vertex) const
+  {
+    return std::make_pair(m_offsets[vertex], m_offsets[vertex + 1]);
+  }
+
+  uint32_t
+  GetEdgeTarget(uint32_t edge) const
+  {
+    return m_targets[edge];
+  }
+
+  uint16_t
+  GetEdgeMetric(uint32_t edge) const
+  {
+    return m_metrics[edge];
+  }
+
+  /**
+   * @brief Get face index of @p edge, or NO_FACE if the edge leaves a channel
+   */
+  uint32_t
+  GetEdgeFace(uint32_t edge) const
+  {
+    return m_edgeFaces[edge];
+  }
+
+private:
+  void
+  search(uint32_t root, bool isReverse, Search& search) const;
+
+  /**
+   * @brief Settle vertices queued in @p search, relaxing their edges
+   */
+  void
+  propagate(bool isReverse, Search& search) const;
+
+  /**
+   * @brief Update shortest paths from @p source after the metric of @p edge changed
+   * @return whether @p search may have changed
+   */
+  bool
+  repair(uint32_t source, uint32_t edge, Search& search) const;
+
+  void
+  forEachSearch(size_t nSearches, const std::function<void(size_t, Search&)>& run) const;
+
+private:
+  std::vector<Ptr<GlobalRouter>> m_routers;
+  size_t m_nNodes;
+
+  std::vector<uint32_t> m_offsets; ///< @brief out-edges of v are [m_offsets[v], m_offsets[v + 1])
+  std::vector<uint32_t> m_targets;
+  std::vector<uint16_t> m_metrics;
+  std::vector<uint32_t> m_edgeFaces; ///< @brief index in m_faces, or NO_FACE
+  std::vector<uint32_t> m_edgeSources;
+
+  /// @brief in-edges of v are m_reverseEdges[m_reverseOffsets[v] .. m_reverseOffsets[v + 1])
+  std::vector<uint32_t> m_reverseOffsets;
+  std::vector<uint32_t> m_reverseEdges;
+
+  std::vector<shared_ptr<Face>> m_faces;
+  std::unordered_map<const Face*, uint32_t> m_faceIndices;
+  std::vector<uint32_t> m_faceEdges;   ///< @brief edge of each face
+  std::vector<uint16_t> m_faceMetrics; ///< @brief metric of each face while it is up
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_HELPER_NDN_GLOBAL_ROUTING_GRAPH_HPP
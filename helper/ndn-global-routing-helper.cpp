@@ -29,6 +29,7 @@
 #include "helper/ndn-fib-helper.hpp"
 #include "model/ndn-net-device-transport.hpp"
 #include "model/ndn-global-router.hpp"
+#include "helper/ndn-global-routing-graph.hpp"
 
 #include "daemon/table/fib.hpp"
 #include "daemon/fw/forwarder.hpp"
@@ -46,23 +47,122 @@
 #include "ns3/node-list.h"
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
+#include "ns3/simulator.h"
 
-#include <boost/lexical_cast.hpp>
-#include <boost/foreach.hpp>
-#include <boost/concept/assert.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-
-#include <unordered_map>
-
-#include "boost-graph-ndn-global-routing-helper.hpp"
-
-#include <math.h>
+#include <map>
+#include <numeric>
+#include <set>
 
 NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelper");
 
 namespace ns3 {
 namespace ndn {
 
+namespace {
+
+/**
+ * @brief Results of the last CalculateRoutes, kept for incremental repairs on link changes
+ */
+struct RoutingState
+{
+  struct Route
+  {
+    uint32_t face;
+    uint32_t distance;
+  };
+
+  struct Change
+  {
+    size_t prefix;
+    uint32_t face;
+    uint32_t distance; ///< @brief INFINITE_DISTANCE if the next hop has to be removed
+  };
+
+  /**
+   * @brief Record routes of source @p i found by @p search
+   * @return changes of next hops in the FIB of the source since the last update
+   */
+  std::vector<Change>
+  update(size_t i, const GlobalRouterGraph::Search& search);
+
+  /**
+   * @brief Get next hops of prefix @p prefix given routes to all origins
+   *
+   * Origins are processed in order, so when several origins of the prefix are reached through
+   * the same face, the last one sets the cost, as with AddRoutesDirect.
+   */
+  std::map<uint32_t, uint32_t>
+  getNextHops(size_t prefix, const std::vector<Route>& routes) const;
+
+  GlobalRouterGraph graph;
+  std::vector<uint32_t> sources;
+  std::vector<uint32_t> origins;
+  std::vector<std::vector<size_t>> originPrefixes; ///< @brief prefixes of each origin
+  std::vector<Name> prefixes;
+  std::vector<std::vector<size_t>> prefixOrigins; ///< @brief origins of each prefix, in order
+  std::vector<std::vector<Route>> routes;         ///< @brief routes of each source to all origins
+  std::vector<GlobalRouterGraph::Search> trees;   ///< @brief searches of all sources, if kept
+};
+
+bool g_isIncrementalRouting = false;
+std::unique_ptr<RoutingState> g_routingState;
+
+std::vector<RoutingState::Change>
+RoutingState::update(size_t i, const GlobalRouterGraph::Search& search)
+{
+  std::vector<Route> current(origins.size());
+  for (size_t origin = 0; origin < origins.size(); origin++) {
+    current[origin] = {search.firstHop[origins[origin]], search.distance[origins[origin]]};
+  }
+  routes[i].swap(current);
+
+  std::vector<Change> changes;
+  if (current.empty())
+    return changes; // initial calculation
+
+  std::set<size_t> changedPrefixes;
+  for (size_t origin = 0; origin < origins.size(); origin++) {
+    if (current[origin].face != routes[i][origin].face
+        || current[origin].distance != routes[i][origin].distance) {
+      changedPrefixes.insert(originPrefixes[origin].begin(), originPrefixes[origin].end());
+    }
+  }
+
+  for (size_t prefix : changedPrefixes) {
+    auto before = getNextHops(prefix, current);
+    auto after = getNextHops(prefix, routes[i]);
+    for (const auto& nextHop : before) {
+      if (after.count(nextHop.first) == 0)
+        changes.push_back({prefix, nextHop.first, GlobalRouterGraph::INFINITE_DISTANCE});
+    }
+    for (const auto& nextHop : after) {
+      auto old = before.find(nextHop.first);
+      if (old == before.end() || old->second != nextHop.second)
+        changes.push_back({prefix, nextHop.first, nextHop.second});
+    }
+  }
+  return changes;
+}
+
+std::map<uint32_t, uint32_t>
+RoutingState::getNextHops(size_t prefix, const std::vector<Route>& routes) const
+{
+  std::map<uint32_t, uint32_t> nextHops;
+  for (size_t origin : prefixOrigins[prefix]) {
+    if (routes[origin].face != GlobalRouterGraph::NO_FACE)
+      nextHops[routes[origin].face] = routes[origin].distance;
+  }
+  return nextHops;
+}
+
+void
+clearRoutingState()
+{
+  g_routingState.reset();
+}
+
+} // namespace
+
 void
 GlobalRoutingHelper::Install(Ptr<Node> node)
 {
@@ -217,172 +317,193 @@ GlobalRoutingHelper::AddOriginsForAll()
 void
 GlobalRoutingHelper::CalculateRoutes()
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
-
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+  std::unique_ptr<RoutingState> state = make_unique<RoutingState>();
+  GlobalRouterGraph& graph = state->graph;
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  state->sources.resize(graph.GetNNodes());
+  std::iota(state->sources.begin(), state->sources.end(), 0);
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
+  std::map<Name, size_t> prefixIndices;
+  for (uint32_t vertex : state->sources) {
+    const auto& localPrefixes = graph.GetRouter(vertex)->GetLocalPrefixes();
+    if (localPrefixes.empty())
       continue;
+
+    state->originPrefixes.emplace_back();
+    for (const auto& prefix : localPrefixes) {
+      auto index = prefixIndices.insert(std::make_pair(*prefix, state->prefixes.size()));
+      if (index.second) {
+        state->prefixes.push_back(*prefix);
+        state->prefixOrigins.emplace_back();
+      }
+      state->originPrefixes.back().push_back(index.first->second);
+      state->prefixOrigins[index.first->second].push_back(state->origins.size());
     }
+    state->origins.push_back(vertex);
+  }
 
-    boost::DistancesMap distances;
+  // searches run in worker threads, so only record indices there and build FIB entries after
+  state->routes.resize(state->sources.size());
+  if (g_isIncrementalRouting) {
+    state->trees.resize(state->sources.size());
+  }
+  graph.ShortestPathsFrom(state->sources, [&] (size_t i, const GlobalRouterGraph::Search& search) {
+      state->update(i, search);
+      if (g_isIncrementalRouting) {
+        state->trees[i] = search;
+      }
+    });
 
-    dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
+  for (size_t i = 0; i < state->sources.size(); i++) {
+    Ptr<Node> node = graph.GetRouter(state->sources[i])->GetObject<Node>();
+    NS_LOG_DEBUG("Reachability from Node: " << node->GetId());
 
-    // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+    std::vector<FibHelper::Route> routes;
+    for (size_t origin = 0; origin < state->origins.size(); origin++) {
+      const auto& route = state->routes[i][origin];
+      if (route.face == GlobalRouterGraph::NO_FACE)
+        continue;
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+      const shared_ptr<Face>& face = graph.GetFace(route.face);
+      for (size_t prefix : state->originPrefixes[origin]) {
+        NS_LOG_DEBUG(" prefix " << state->prefixes[prefix] << " reachable via face " << *face
+                     << " with distance " << route.distance);
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
-    for (const auto& dist : distances) {
-      if (dist.first == source)
-        continue;
-      else {
-        // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-        if (std::get<0>(dist.second) == 0) {
-          // cout << " is unreachable" << endl;
-        }
-        else {
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
-                         << " with distance " << std::get<1>(dist.second) << " with delay "
-                         << std::get<2>(dist.second));
-
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
-          }
-        }
+        routes.push_back({state->prefixes[prefix], face, static_cast<int32_t>(route.distance)});
       }
     }
+    FibHelper::AddRoutesDirect(node, routes);
+  }
+
+  if (g_isIncrementalRouting) {
+    if (g_routingState == nullptr) {
+      Simulator::ScheduleDestroy(&clearRoutingState);
+    }
+    g_routingState = std::move(state);
   }
 }
 
 void
-GlobalRoutingHelper::CalculateAllPossibleRoutes()
+GlobalRoutingHelper::SetIncrementalRouting(bool isEnabled)
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
-
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+  g_isIncrementalRouting = isEnabled;
+  if (!isEnabled) {
+    g_routingState.reset();
+  }
+}
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+void
+GlobalRoutingHelper::UpdateRoutes(const std::vector<shared_ptr<Face>>& faces, bool isUp)
+{
+  if (g_routingState == nullptr)
+    return;
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
+  RoutingState& state = *g_routingState;
+  for (const auto& face : faces) {
+    uint32_t edge = state.graph.SetFaceUp(*face, isUp);
+    if (edge == GlobalRouterGraph::NO_EDGE)
       continue;
-    }
-
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId() << " ("
-                                            << Names::FindName(source->GetObject<Node>()) << ")");
+    NS_LOG_DEBUG("Face " << *face << (isUp ? " up" : " down") << ", repairing routes");
 
-    Ptr<L3Protocol> l3 = source->GetObject<L3Protocol>();
-    NS_ASSERT(l3 != 0);
+    std::vector<std::vector<RoutingState::Change>> changes(state.sources.size());
+    state.graph.RepairShortestPathsFrom(state.sources, edge, state.trees,
+                                        [&] (size_t i, const GlobalRouterGraph::Search& search) {
+                                          changes[i] = state.update(i, search);
+                                        });
 
-    // remember interface statuses
-    std::list<nfd::FaceId> faceIds;
-    std::unordered_map<nfd::FaceId, uint16_t> originalMetrics;
-    for (auto& nfdFace : l3->getForwarder()->getFaceTable()) {
-      faceIds.push_back(nfdFace.getId());
-      originalMetrics[nfdFace.getId()] = nfdFace.getMetric();
-      nfdFace.setMetric(std::numeric_limits<uint16_t>::max() - 1);
-      // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
-    }
-
-    for (auto& faceId : faceIds) {
-      auto* face = l3->getForwarder()->getFaceTable().get(faceId);
-      NS_ASSERT(face != nullptr);
-      auto transport = dynamic_cast<NetDeviceTransport*>(face->getTransport());
-      if (transport == nullptr) {
-        NS_LOG_DEBUG("Skipping non ndnSIM-specific transport face");
+    for (size_t i = 0; i < state.sources.size(); i++) {
+      if (changes[i].empty())
         continue;
-      }
 
-      // enabling only faceId
-      face->setMetric(originalMetrics[faceId]);
-
-      boost::DistancesMap distances;
+      std::vector<FibHelper::Route> removed;
+      std::vector<FibHelper::Route> added;
+      for (const auto& change : changes[i]) {
+        FibHelper::Route route{state.prefixes[change.prefix], state.graph.GetFace(change.face),
+                               static_cast<int32_t>(change.distance)};
+        if (change.distance == GlobalRouterGraph::INFINITE_DISTANCE)
+          removed.push_back(route);
+        else
+          added.push_back(route);
+      }
 
-      NS_LOG_DEBUG("-----------");
+      Ptr<Node> node = state.graph.GetRouter(state.sources[i])->GetObject<Node>();
+      FibHelper::RemoveRoutesDirect(node, removed);
+      FibHelper::AddRoutesDirect(node, added);
+    }
+  }
+}
 
-      dijkstra_shortest_paths(graph, source,
-                              // predecessor_map (boost::ref(predecessors))
-                              // .
-                              distance_map(boost::ref(distances))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
+void
+GlobalRoutingHelper::CalculateAllPossibleRoutes()
+{
+  GlobalRouterGraph graph;
 
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+  std::vector<uint32_t> origins;
+  for (uint32_t vertex = 0; vertex < graph.GetNNodes(); vertex++) {
+    if (!graph.GetRouter(vertex)->GetLocalPrefixes().empty())
+      origins.push_back(vertex);
+  }
 
-      for (const auto& dist : distances) {
-        if (dist.first == source)
+  struct Reachability
+  {
+    uint32_t node;
+    uint32_t face;
+    uint32_t distance;
+  };
+
+  // One search towards each origin gives distances of all vertices to it.  The cost of every
+  // face of a node is then the face metric plus the distance of the vertex on the other side,
+  // over paths that do not come back through the node itself (the same as computing routes from
+  // the node with all its other faces disabled).
+  std::vector<std::vector<Reachability>> reachability(origins.size());
+  graph.ShortestPathsTo(origins, [&] (size_t i, GlobalRouterGraph::Search& search) {
+      search.IndexTree();
+      std::vector<uint32_t> detours;
+
+      for (uint32_t node = 0; node < graph.GetNNodes(); node++) {
+        if (node == origins[i] || search.distance[node] >= GlobalRouterGraph::INFINITE_DISTANCE)
           continue;
-        else {
-          // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-          if (std::get<0>(dist.second) == 0) {
-            // cout << " is unreachable" << endl;
-          }
-          else {
-            for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-              NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face "
-                           << *std::get<0>(dist.second)
-                           << " with distance " << std::get<1>(dist.second)
-                           << " with delay " << std::get<2>(dist.second));
-
-              if (std::get<0>(dist.second)->getMetric() == std::numeric_limits<uint16_t>::max() - 1)
-                continue;
-
-              FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                  std::get<1>(dist.second));
+
+        bool hasDetours = false;
+        auto edges = graph.GetOutEdges(node);
+        for (uint32_t edge = edges.first; edge < edges.second; edge++) {
+          uint32_t neighbor = graph.GetEdgeTarget(edge);
+          uint32_t distance = search.distance[neighbor];
+          if (search.IsOnTreePath(node, neighbor)) {
+            if (!hasDetours) {
+              graph.DetourDistances(search, node, detours);
+              hasDetours = true;
             }
+            distance = detours[search.GetSubtreeIndex(node, neighbor)];
           }
+
+          distance += graph.GetEdgeMetric(edge);
+          if (distance >= GlobalRouterGraph::INFINITE_DISTANCE)
+            continue;
+
+          reachability[i].push_back({node, graph.GetEdgeFace(edge), distance});
         }
       }
-
-      // disabling the face again
-      face->setMetric(std::numeric_limits<uint16_t>::max() - 1);
+    });
+
+  std::vector<std::vector<FibHelper::Route>> routes(graph.GetNNodes());
+  for (size_t i = 0; i < origins.size(); i++) {
+    const auto& prefixes = graph.GetRouter(origins[i])->GetLocalPrefixes();
+    for (const auto& entry : reachability[i]) {
+      const shared_ptr<Face>& face = graph.GetFace(entry.face);
+      for (const auto& prefix : prefixes) {
+        NS_LOG_DEBUG("Node " << graph.GetRouter(entry.node)->GetObject<Node>()->GetId()
+                     << ": prefix " << *prefix << " reachable via face " << *face
+                     << " with distance " << entry.distance);
+
+        routes[entry.node].push_back({*prefix, face, static_cast<int32_t>(entry.distance)});
+      }
     }
+  }
 
-    // recover original interface statuses
-    for (auto& i : originalMetrics) {
-      l3->getForwarder()->getFaceTable().get(i.first)->setMetric(i.second);
-    }
+  for (uint32_t node = 0; node < graph.GetNNodes(); node++) {
+    FibHelper::AddRoutesDirect(graph.GetRouter(node)->GetObject<Node>(), routes[node]);
   }
 }
 
@@ -24,6 +24,8 @@
 
 #include "ns3/ptr.h"
 
+#include <vector>
+
 namespace ns3 {
 
 class Node;
@@ -96,17 +98,41 @@ public:
 
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
+   *
+   * Shortest path trees are computed in parallel over a GlobalRouterGraph snapshot, and routes
+   * are installed once all of them are known.
    */
   static void
   CalculateRoutes();
 
   /**
-   * @brief Calculate all possible next-hop independent alternative routes
+   * @brief Keep the results of CalculateRoutes to repair routes incrementally on link changes
    *
-   * Refer to the implementation for more details.
+   * When enabled, CalculateRoutes keeps its GlobalRouterGraph snapshot and the shortest path
+   * trees of all nodes until the simulator is destroyed, and UpdateRoutes (called by
+   * LinkControlHelper::FailLink and UpLink) repairs them.  Memory use grows with the square of
+   * the number of nodes and channels.  Disabled by default.
+   */
+  static void
+  SetIncrementalRouting(bool isEnabled);
+
+  /**
+   * @brief Update routes installed by CalculateRoutes after @p faces went down or came back up
+   *
+   * Only shortest path trees affected by the change are repaired, and only next hops that
+   * have changed are removed from or added to the FIBs.  Does nothing unless incremental
+   * routing is enabled and routes have been calculated.
+   */
+  static void
+  UpdateRoutes(const std::vector<shared_ptr<Face>>& faces, bool isUp);
+
+  /**
+   * @brief Calculate all possible next-hop independent alternative routes
    *
-   * Note that this method is highly experimental and should be used with caution (very time
-   *consuming).
+   * Every face of every node gets a route to each prefix origin reachable through it, with the
+   * cost of the shortest path that starts with this face and does not return to the node.
+   * Costs are derived from one reverse shortest path search per origin; searches run in
+   * parallel and face metrics are not modified.
    */
   static void
   CalculateAllPossibleRoutes();
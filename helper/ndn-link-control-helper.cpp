@@ -33,6 +33,7 @@
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-transport.hpp"
+#include "helper/ndn-global-routing-helper.hpp"
 #include "NFD/daemon/face/face.hpp"
 
 #include "fw/forwarder.hpp"
@@ -56,7 +57,7 @@ LinkControlHelper::setErrorRate(Ptr<Node> node1, Ptr<Node> node2, double errorRa
   NS_ASSERT(ndn1 != nullptr && ndn2 != nullptr);
 
   // iterate over all faces to find the right one
-  for (const auto& face : ndn1->getForwarder()->getFaceTable()) {
+  for (auto& face : ndn1->getForwarder()->getFaceTable()) {
     auto transport = dynamic_cast<NetDeviceTransport*>(face.getTransport());
     if (transport == nullptr)
       continue;
@@ -85,6 +86,16 @@ LinkControlHelper::setErrorRate(Ptr<Node> node1, Ptr<Node> node2, double errorRa
 
       nd1->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
       nd2->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
+
+      // let global routing move routes off (or back onto) the link
+      std::vector<shared_ptr<Face>> faces{face.shared_from_this()};
+      for (auto& otherFace : ndn2->getForwarder()->getFaceTable()) {
+        auto otherTransport = dynamic_cast<NetDeviceTransport*>(otherFace.getTransport());
+        if (otherTransport != nullptr && otherTransport->GetNetDevice() == nd2) {
+          faces.push_back(otherFace.shared_from_this());
+        }
+      }
+      GlobalRoutingHelper::UpdateRoutes(faces, errorRate < 1.0);
       return;
     }
   }
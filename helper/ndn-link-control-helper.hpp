@@ -43,6 +43,9 @@ public:
    *
    * Note that only PointToPointChannels are supported by this helper method
    *
+   * If incremental routing is enabled in GlobalRoutingHelper, routes calculated by it are
+   * moved off the link (see GlobalRoutingHelper::UpdateRoutes).
+   *
    * @param node1 one node
    * @param node2 another node
    */
@@ -73,6 +76,9 @@ public:
    *
    * Note that only PointToPointChannels are supported by this helper method
    *
+   * If incremental routing is enabled in GlobalRoutingHelper, routes calculated by it are
+   * updated to use the link again (see GlobalRoutingHelper::UpdateRoutes).
+   *
    * @param node1 one node
    * @param node2 another node
    */
@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-mobility-routing-helper.hpp"
+
+#include "model/ndn-l3-protocol.hpp"
+
+#include "ns3/log.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/sta-wifi-mac.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.MobilityRoutingHelper");
+
+namespace ns3 {
+namespace ndn {
+
+void
+MobilityRoutingHelper::AddUplinkPrefix(const Name& prefix, int32_t metric)
+{
+  m_uplinkPrefixes.push_back(std::make_pair(prefix, metric));
+}
+
+void
+MobilityRoutingHelper::Install(Ptr<Node> node) const
+{
+  Ptr<L3Protocol> l3 = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(l3 != nullptr, "Cannot install MobilityRoutingHelper on a node without NDN stack");
+
+  for (uint32_t i = 0; i < node->GetNDevices(); i++) {
+    Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(node->GetDevice(i));
+    if (device == nullptr || DynamicCast<StaWifiMac>(device->GetMac()) == nullptr) {
+      continue;
+    }
+
+    shared_ptr<Face> face = l3->getFaceByNetDevice(device);
+    NS_ASSERT_MSG(face != nullptr, "There is no face associated with the wifi STA device");
+
+    std::vector<FibHelper::Route> routes;
+    for (const auto& prefix : m_uplinkPrefixes) {
+      routes.push_back({prefix.first, face, prefix.second});
+    }
+
+    Ptr<WifiAssociation> association = node->GetObject<WifiAssociation>();
+    NS_ASSERT_MSG(association == nullptr, "MobilityRoutingHelper is already installed on the node");
+    association = CreateObject<WifiAssociation>();
+    node->AggregateObject(association);
+    association->SetDevice(device, routes);
+    return;
+  }
+
+  NS_LOG_WARN("Node " << node->GetId() << " has no wifi STA device, nothing to follow");
+}
+
+void
+MobilityRoutingHelper::Install(const NodeContainer& nodes) const
+{
+  for (auto node = nodes.Begin(); node != nodes.End(); node++) {
+    Install(*node);
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
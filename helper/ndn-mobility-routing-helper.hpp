@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_HELPER_NDN_MOBILITY_ROUTING_HELPER_HPP
+#define NDNSIM_HELPER_NDN_MOBILITY_ROUTING_HELPER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-wifi-association.hpp"
+
+#include "ns3/node-container.h"
+
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to keep routes of mobile wifi STAs in sync with their association
+ *
+ * Instead of static routes on the STA device, which keep pointing into the air after a
+ * handoff, the uplink routes are installed when the STA associates with an AP and removed
+ * when it disassociates.  See WifiAssociation.
+ *
+ * The NDN stack must be installed on the STA nodes beforehand.
+ */
+class MobilityRoutingHelper {
+public:
+  /**
+   * @brief Route @p prefix from the STAs to the serving AP with @p metric
+   */
+  void
+  AddUplinkPrefix(const Name& prefix, int32_t metric);
+
+  /**
+   * @brief Follow association of the first wifi STA device of @p node
+   */
+  void
+  Install(Ptr<Node> node) const;
+
+  void
+  Install(const NodeContainer& nodes) const;
+
+private:
+  std::vector<std::pair<Name, int32_t>> m_uplinkPrefixes;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_HELPER_NDN_MOBILITY_ROUTING_HELPER_HPP
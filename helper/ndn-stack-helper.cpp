@@ -24,6 +24,9 @@
 #include "ns3/string.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/point-to-point-channel.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/adhoc-wifi-mac.h"
+#include "ns3/ap-wifi-mac.h"
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-transport.hpp"
@@ -51,6 +54,8 @@ StackHelper::StackHelper()
   , m_isStrategyChoiceManagerDisabled(false)
   , m_needSetDefaultRoutes(false)
   , m_maxCsSize(100)
+  , m_inMemoryPackets(false)
+  , m_wifiNeighborTimeout(Seconds(1))
 {
   setCustomNdnCxxClocks();
 
@@ -135,6 +140,48 @@ StackHelper::setCsSize(size_t maxSize)
   m_maxCsSize = maxSize;
 }
 
+void
+StackHelper::SetInMemoryPackets(bool enable)
+{
+  m_inMemoryPackets = enable;
+}
+
+void
+StackHelper::SetUnicastNextHop(TypeId netDeviceType, bool enable)
+{
+  if (enable) {
+    m_unicastNetDeviceTypes.insert(netDeviceType);
+  }
+  else {
+    m_unicastNetDeviceTypes.erase(netDeviceType);
+  }
+}
+
+void
+StackHelper::SetWifiNeighborFaces(bool enable, Time neighborTimeout)
+{
+  m_wifiNeighborTimeout = neighborTimeout;
+
+  FaceCreateCallback callback = MakeCallback(&StackHelper::WifiNetDeviceCallback, this);
+  m_netDeviceCallbacks.remove_if([&] (const std::pair<TypeId, FaceCreateCallback>& i) {
+      return i.first == WifiNetDevice::GetTypeId() && i.second.IsEqual(callback);
+    });
+  if (enable) {
+    AddFaceCreateCallback(WifiNetDevice::GetTypeId(), callback);
+  }
+}
+
+bool
+StackHelper::isUnicastNextHop(Ptr<NetDevice> netDevice) const
+{
+  for (const auto& type : m_unicastNetDeviceTypes) {
+    if (netDevice->GetInstanceTypeId() == type || netDevice->GetInstanceTypeId().IsChildOf(type)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void
 StackHelper::setPolicy(const std::string& policy)
 {
@@ -280,6 +327,82 @@ StackHelper::DefaultNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
   auto transport = make_unique<NetDeviceTransport>(node, netDevice,
                                                    constructFaceUri(netDevice),
                                                    "netdev://[ff:ff:ff:ff:ff:ff]");
+  transport->SetInMemoryPackets(m_inMemoryPackets);
+  transport->SetUnicast(isUnicastNextHop(netDevice));
+
+  // an AP addresses each STA on its own face
+  Ptr<WifiNetDevice> wifiDevice = DynamicCast<WifiNetDevice>(netDevice);
+  if (isUnicastNextHop(netDevice) && wifiDevice != nullptr &&
+      DynamicCast<ApWifiMac>(wifiDevice->GetMac()) != nullptr) {
+    enableNeighborFaces(node, ndn, netDevice, *transport);
+  }
+
+  auto face = std::make_shared<Face>(std::move(linkService), std::move(transport));
+  face->setMetric(1);
+
+  ndn->addFace(face);
+  NS_LOG_LOGIC("Node " << node->GetId() << ": added Face as face #"
+                       << face->getLocalUri());
+
+  return face;
+}
+
+void
+StackHelper::enableNeighborFaces(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> netDevice,
+                                 NetDeviceTransport& transport) const
+{
+  ::nfd::face::GenericLinkService::Options opts;
+  opts.allowFragmentation = true;
+  opts.allowReassembly = true;
+
+  std::string localUri = constructFaceUri(netDevice);
+  bool inMemoryPackets = m_inMemoryPackets;
+  transport.EnableNeighborFaces([=] (const Mac48Address& neighbor) {
+      auto neighborLinkService = make_unique<::nfd::face::GenericLinkService>(opts);
+      auto neighborTransport = make_unique<NetDeviceTransport>(node, netDevice, localUri, neighbor);
+      neighborTransport->SetInMemoryPackets(inMemoryPackets);
+
+      auto face = std::make_shared<Face>(std::move(neighborLinkService),
+                                         std::move(neighborTransport));
+      face->setMetric(1);
+
+      ndn->addFace(face);
+      NS_LOG_LOGIC("Node " << node->GetId() << ": added Face to neighbor " << neighbor
+                           << " as face #" << face->getId());
+      return face;
+    }, m_wifiNeighborTimeout);
+}
+
+shared_ptr<Face>
+StackHelper::WifiNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
+                                   Ptr<NetDevice> device) const
+{
+  Ptr<WifiNetDevice> netDevice = DynamicCast<WifiNetDevice>(device);
+  NS_ASSERT(netDevice != nullptr);
+
+  if (DynamicCast<AdhocWifiMac>(netDevice->GetMac()) == nullptr) {
+    // infrastructure devices get the default face
+    return nullptr;
+  }
+
+  NS_LOG_DEBUG("Creating ad hoc wifi Face on node " << node->GetId());
+
+  // Create an ndnSIM-specific transport instance
+  ::nfd::face::GenericLinkService::Options opts;
+  opts.allowFragmentation = true;
+  opts.allowReassembly = true;
+
+  auto linkService = make_unique<::nfd::face::GenericLinkService>(opts);
+
+  std::string localUri = constructFaceUri(netDevice);
+  auto transport = make_unique<NetDeviceTransport>(node, netDevice, localUri,
+                                                   "netdev://[ff:ff:ff:ff:ff:ff]",
+                                                   ::ndn::nfd::FACE_SCOPE_NON_LOCAL,
+                                                   ::ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                                                   ::ndn::nfd::LINK_TYPE_AD_HOC);
+  transport->SetInMemoryPackets(m_inMemoryPackets);
+
+  enableNeighborFaces(node, ndn, netDevice, *transport);
 
   auto face = std::make_shared<Face>(std::move(linkService), std::move(transport));
   face->setMetric(1);
@@ -318,6 +441,8 @@ StackHelper::PointToPointNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
   auto transport = make_unique<NetDeviceTransport>(node, netDevice,
                                                    constructFaceUri(netDevice),
                                                    constructFaceUri(remoteNetDevice));
+  transport->SetInMemoryPackets(m_inMemoryPackets);
+  transport->SetUnicast(isUnicastNextHop(netDevice));
 
   auto face = std::make_shared<Face>(std::move(linkService), std::move(transport));
   face->setMetric(1);
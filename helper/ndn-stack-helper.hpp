@@ -31,6 +31,8 @@
 #include "ndn-fib-helper.hpp"
 #include "ndn-strategy-choice-helper.hpp"
 
+#include <set>
+
 namespace nfd {
 namespace cs {
 class Policy;
@@ -44,6 +46,7 @@ class Node;
 namespace ndn {
 
 class L3Protocol;
+class NetDeviceTransport;
 
 /**
  * @ingroup ndn
@@ -190,6 +193,49 @@ public:
   void
   SetDefaultRoutes(bool needSet);
 
+  /**
+   * \brief Pass NDN packets between NetDevice faces by reference instead of serializing them
+   *
+   * Packets keep their true size on the wire, but carry no bytes (see BlockTag), which saves
+   * encoding, copying and parsing on every hop.  Pcap traces will not contain NDN packets.
+   * Applies to faces created after the call.  A sent packet can still be received for the
+   * time given by the global value NdnBlockLifetime (1 second by default), later deliveries are
+   * dropped (see BlockTag).
+   */
+  void
+  SetInMemoryPackets(bool enable);
+
+  /**
+   * \brief Address packets on faces of \p netDeviceType (or derived) devices to the next hop
+   *        instead of the broadcast address
+   *
+   * Only wifi devices support it at the moment (see NetDeviceTransport::SetUnicast), e.g.
+   *
+   *     ndnHelper.SetUnicastNextHop(WifiNetDevice::GetTypeId());
+   *
+   * A wifi AP device additionally gets a unicast face for every associated STA (with the
+   * neighbor timeout of SetWifiNeighborFaces for STAs not followed by WifiAssociation), so
+   * that Data is sent only to the STAs that asked for it.
+   *
+   * Applies to faces created after the call.
+   */
+  void
+  SetUnicastNextHop(TypeId netDeviceType, bool enable = true);
+
+  /**
+   * \brief Create per-neighbor faces on ad hoc wifi devices
+   *
+   * When enabled, an ad hoc WifiNetDevice gets a multi-access face (LINK_TYPE_AD_HOC) for
+   * broadcast, as before, plus a unicast face for every node heard on the device.  A
+   * neighbor's face is closed after nothing has been heard from it for \p neighborTimeout.
+   * Forwarding strategies can then send to (and keep per-face measurements of) individual
+   * vehicles instead of flooding all of them.  Other wifi devices are not affected.
+   *
+   * Applies to faces created after the call.
+   */
+  void
+  SetWifiNeighborFaces(bool enable, Time neighborTimeout = Seconds(1));
+
   static KeyChain&
   getKeyChain();
 
@@ -249,12 +295,25 @@ public:
   disableForwarderStatusManager();
 
 private:
+  bool
+  isUnicastNextHop(Ptr<NetDevice> netDevice) const;
+
   shared_ptr<Face>
   DefaultNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> netDevice) const;
 
+  /**
+   * \brief Let \p transport create faces to individual neighbors on \p netDevice
+   */
+  void
+  enableNeighborFaces(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> netDevice,
+                      NetDeviceTransport& transport) const;
+
   shared_ptr<Face>
   PointToPointNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
                                 Ptr<NetDevice> netDevice) const;
+  shared_ptr<Face>
+  WifiNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> netDevice) const;
+
   shared_ptr<Face>
   createAndRegisterFace(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> device) const;
 
@@ -273,6 +332,9 @@ private:
 
   bool m_needSetDefaultRoutes;
   size_t m_maxCsSize;
+  bool m_inMemoryPackets;
+  std::set<TypeId> m_unicastNetDeviceTypes;
+  Time m_wifiNeighborTimeout;
 
   typedef std::function<std::unique_ptr<nfd::cs::Policy>()> PolicyCreationCallback;
   PolicyCreationCallback m_csPolicyCreationFunc;
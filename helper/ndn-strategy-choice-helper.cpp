@@ -63,6 +63,23 @@ StrategyChoiceHelper::Install(Ptr<Node> node, const Name& namePrefix, const Name
   sendCommand(parameters, node);
 }
 
+void
+StrategyChoiceHelper::InstallDirect(const NodeContainer& c, const Name& namePrefix,
+                                    const Name& strategy)
+{
+  for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
+    Ptr<L3Protocol> l3Protocol = (*i)->GetObject<L3Protocol>();
+    NS_ASSERT(l3Protocol != nullptr);
+    NS_LOG_DEBUG("Node ID: " << (*i)->GetId() << " with forwarding strategy " << strategy);
+
+    auto result = l3Protocol->getForwarder()->getStrategyChoice().insert(namePrefix, strategy);
+    if (!result) {
+      NS_FATAL_ERROR("Cannot install strategy " << strategy << " for " << namePrefix
+                     << " on node " << (*i)->GetId() << ": " << result);
+    }
+  }
+}
+
 void
 StrategyChoiceHelper::InstallAll(const Name& namePrefix, const Name& strategy)
 {
@@ -79,6 +79,17 @@ public:
   static void
   InstallAll(const Name& namePrefix, const Name& strategy);
 
+  /**
+   * @brief Install a built-in (or already registered) strategy @p strategy on nodes in @p c
+   *        container for @p namePrefix namespace, writing directly into the Strategy Choice
+   *        tables
+   *
+   * Has the same effect as Install, but without building, signing and processing a
+   * management command per node.
+   */
+  static void
+  InstallDirect(const NodeContainer& c, const Name& namePrefix, const Name& strategy);
+
   /**
    * @brief Install a custom strategy on @p node for @p namePrefix namespace
    * @tparam Strategy Class name of the custom strategy
@@ -33,6 +33,8 @@
 
 #include "ns3/random-variable-stream.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/traced-value.h"
 
 #include "../../utils/trie/trie-with-policy.hpp"
 
@@ -80,22 +82,24 @@ private:
 /**
  * @ingroup ndn-cs
  * @brief Base implementation of NDN content store
+ *
+ * Nodes of the name trie are obtained from @p Allocator, by default a pool owned by the store
+ * (see ndnSIM::pool_allocator).
  */
-template<class Policy>
+template<class Policy, template<class, class> class Allocator = ndnSIM::pool_allocator>
 class ContentStoreImpl
   : public ContentStore,
-    protected ndnSIM::
-      trie_with_policy<Name,
-                       ndnSIM::smart_pointer_payload_traits<EntryImpl<ContentStoreImpl<Policy>>,
-                                                            Entry>,
-                       Policy> {
+    protected ndnSIM::trie_with_policy<Name,
+                                       ndnSIM::smart_pointer_payload_traits<
+                                         EntryImpl<ContentStoreImpl<Policy, Allocator>>, Entry>,
+                                       Policy, Allocator> {
 public:
-  typedef ndnSIM::
-    trie_with_policy<Name, ndnSIM::smart_pointer_payload_traits<EntryImpl<ContentStoreImpl<Policy>>,
-                                                                Entry>,
-                     Policy> super;
+  typedef ndnSIM::trie_with_policy<Name,
+                                   ndnSIM::smart_pointer_payload_traits<
+                                     EntryImpl<ContentStoreImpl<Policy, Allocator>>, Entry>,
+                                   Policy, Allocator> super;
 
-  typedef EntryImpl<ContentStoreImpl<Policy>> entry;
+  typedef EntryImpl<ContentStoreImpl<Policy, Allocator>> entry;
 
   static TypeId
   GetTypeId();
@@ -150,12 +154,24 @@ private:
   uint32_t
   GetMaxSize() const;
 
+  void
+  SetMaxBytes(uint64_t maxBytes);
+
+  uint64_t
+  GetMaxBytes() const;
+
   void
   SetHitRatio(double hitRatio);
 
   double
   GetHitRatio() const;
 
+  void
+  SetNameIndex(bool enable);
+
+  bool
+  GetNameIndex() const;
+
 private:
   static LogComponent g_log; ///< @brief Logging variable
 
@@ -165,47 +181,67 @@ private:
 
   double m_hitRatio;
   Ptr<RandomVariableStream> m_random;
+
+protected:
+  /// @brief total size of the cached Data packets, in bytes
+  TracedValue<uint64_t> m_occupiedBytes;
 };
 
 //////////////////////////////////////////
 ////////// Implementation ////////////////
 //////////////////////////////////////////
 
-template<class Policy>
-ContentStoreImpl<Policy>::ContentStoreImpl()
+template<class Policy, template<class, class> class Allocator>
+ContentStoreImpl<Policy, Allocator>::ContentStoreImpl()
 {
   m_random = CreateObject<UniformRandomVariable>();
   m_random->SetAttribute("Min", DoubleValue(0.0));
   m_random->SetAttribute("Max", DoubleValue(1.0));
 }
 
-template<class Policy>
-LogComponent ContentStoreImpl<Policy>::g_log = LogComponent(("ndn.cs." + Policy::GetName()).c_str(), __FILE__);
+template<class Policy, template<class, class> class Allocator>
+LogComponent ContentStoreImpl<Policy, Allocator>::g_log =
+  LogComponent(("ndn.cs." + Policy::GetName()).c_str(), __FILE__);
 
-template<class Policy>
+template<class Policy, template<class, class> class Allocator>
 TypeId
-ContentStoreImpl<Policy>::GetTypeId()
+ContentStoreImpl<Policy, Allocator>::GetTypeId()
 {
   static TypeId tid =
     TypeId(("ns3::ndn::cs::" + Policy::GetName()).c_str())
       .SetGroupName("Ndn")
       .SetParent<ContentStore>()
-      .AddConstructor<ContentStoreImpl<Policy>>()
+      .AddConstructor<ContentStoreImpl>()
       .AddAttribute("MaxSize",
                     "Set maximum number of entries in ContentStore. If 0, limit is not enforced",
-                    StringValue("100"), MakeUintegerAccessor(&ContentStoreImpl<Policy>::GetMaxSize,
-                                                             &ContentStoreImpl<Policy>::SetMaxSize),
+                    StringValue("100"), MakeUintegerAccessor(&ContentStoreImpl::GetMaxSize,
+                                                             &ContentStoreImpl::SetMaxSize),
                     MakeUintegerChecker<uint32_t>())
+      .AddAttribute("MaxBytes",
+                    "Set maximum total size of Data packets in ContentStore, in bytes. "
+                    "If 0, limit is not enforced",
+                    UintegerValue(0), MakeUintegerAccessor(&ContentStoreImpl::GetMaxBytes,
+                                                           &ContentStoreImpl::SetMaxBytes),
+                    MakeUintegerChecker<uint64_t>())
       .AddAttribute("HitRatio",
                     "Simulate cache replacement",
-                    DoubleValue(1.0), MakeDoubleAccessor(&ContentStoreImpl<Policy>::GetHitRatio,
-                                                           &ContentStoreImpl<Policy>::SetHitRatio),
+                    DoubleValue(1.0), MakeDoubleAccessor(&ContentStoreImpl::GetHitRatio,
+                                                           &ContentStoreImpl::SetHitRatio),
                     MakeDoubleChecker<double>(0.0, 1.0))
+      .AddAttribute("NameIndex",
+                    "Keep a full-name hash index for exact-match lookups, insertions and removals",
+                    BooleanValue(true), MakeBooleanAccessor(&ContentStoreImpl::GetNameIndex,
+                                                            &ContentStoreImpl::SetNameIndex),
+                    MakeBooleanChecker())
 
       .AddTraceSource("DidAddEntry",
                       "Trace fired every time entry is successfully added to the cache",
-                      MakeTraceSourceAccessor(&ContentStoreImpl<Policy>::m_didAddEntry),
-                      "ns3::ndn::cs::ContentStoreImpl::CsEntryCallback");
+                      MakeTraceSourceAccessor(&ContentStoreImpl::m_didAddEntry),
+                      "ns3::ndn::cs::ContentStoreImpl::CsEntryCallback")
+      .AddTraceSource("OccupiedBytes",
+                      "Total size of Data packets in ContentStore, in bytes",
+                      MakeTraceSourceAccessor(&ContentStoreImpl::m_occupiedBytes),
+                      "ns3::TracedValueCallback::Uint64");
 
   return tid;
 }
@@ -226,9 +262,9 @@ private:
   const Exclude& m_exclude;
 };
 
-template<class Policy>
+template<class Policy, template<class, class> class Allocator>
 shared_ptr<Data>
-ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
+ContentStoreImpl<Policy, Allocator>::Lookup(shared_ptr<const Interest> interest)
 {
   NS_LOG_FUNCTION(this << interest->getName());
 
@@ -254,14 +290,15 @@ ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
   }
 }
 
-template<class Policy>
+template<class Policy, template<class, class> class Allocator>
 bool
-ContentStoreImpl<Policy>::Add(shared_ptr<const Data> data)
+ContentStoreImpl<Policy, Allocator>::Add(shared_ptr<const Data> data)
 {
   NS_LOG_FUNCTION(this << data->getName());
 
   Ptr<entry> newEntry = Create<entry>(this, data);
   std::pair<typename super::iterator, bool> result = super::insert(data->getName(), newEntry);
+  m_occupiedBytes = super::get_bytes(); // insert may have evicted entries even if it failed
 
   if (result.first != super::end()) {
     if (result.second) {
@@ -280,9 +317,9 @@ ContentStoreImpl<Policy>::Add(shared_ptr<const Data> data)
     return false; // cannot insert entry
 }
 
-template<class Policy>
+template<class Policy, template<class, class> class Allocator>
 void
-ContentStoreImpl<Policy>::Print(std::ostream& os) const
+ContentStoreImpl<Policy, Allocator>::Print(std::ostream& os) const
 {
   for (typename super::policy_container::const_iterator item = this->getPolicy().begin();
        item != this->getPolicy().end(); item++) {
@@ -290,44 +327,72 @@ ContentStoreImpl<Policy>::Print(std::ostream& os) const
   }
 }
 
-template<class Policy>
+template<class Policy, template<class, class> class Allocator>
 void
-ContentStoreImpl<Policy>::SetMaxSize(uint32_t maxSize)
+ContentStoreImpl<Policy, Allocator>::SetMaxSize(uint32_t maxSize)
 {
   this->getPolicy().set_max_size(maxSize);
 }
 
-template<class Policy>
+template<class Policy, template<class, class> class Allocator>
 uint32_t
-ContentStoreImpl<Policy>::GetMaxSize() const
+ContentStoreImpl<Policy, Allocator>::GetMaxSize() const
 {
   return this->getPolicy().get_max_size();
 }
 
-template<class Policy>
+template<class Policy, template<class, class> class Allocator>
+void
+ContentStoreImpl<Policy, Allocator>::SetMaxBytes(uint64_t maxBytes)
+{
+  this->getPolicy().set_max_bytes(maxBytes);
+}
+
+template<class Policy, template<class, class> class Allocator>
+uint64_t
+ContentStoreImpl<Policy, Allocator>::GetMaxBytes() const
+{
+  return this->getPolicy().get_max_bytes();
+}
+
+template<class Policy, template<class, class> class Allocator>
 uint32_t
-ContentStoreImpl<Policy>::GetSize() const
+ContentStoreImpl<Policy, Allocator>::GetSize() const
 {
   return this->getPolicy().size();
 }
 
-template<class Policy>
+template<class Policy, template<class, class> class Allocator>
 void
-ContentStoreImpl<Policy>::SetHitRatio(double hitRatio)
+ContentStoreImpl<Policy, Allocator>::SetHitRatio(double hitRatio)
 {
   m_hitRatio = hitRatio;
 }
 
-template<class Policy>
+template<class Policy, template<class, class> class Allocator>
 double
-ContentStoreImpl<Policy>::GetHitRatio() const
+ContentStoreImpl<Policy, Allocator>::GetHitRatio() const
 {
   return m_hitRatio;
 }
 
-template<class Policy>
+template<class Policy, template<class, class> class Allocator>
+void
+ContentStoreImpl<Policy, Allocator>::SetNameIndex(bool enable)
+{
+  this->set_hash_index(enable);
+}
+
+template<class Policy, template<class, class> class Allocator>
+bool
+ContentStoreImpl<Policy, Allocator>::GetNameIndex() const
+{
+  return this->get_hash_index();
+}
+
+template<class Policy, template<class, class> class Allocator>
 Ptr<Entry>
-ContentStoreImpl<Policy>::Begin()
+ContentStoreImpl<Policy, Allocator>::Begin()
 {
   typename super::parent_trie::recursive_iterator item(super::getTrie()), end(0);
   for (; item != end; item++) {
@@ -342,16 +407,16 @@ ContentStoreImpl<Policy>::Begin()
     return item->payload();
 }
 
-template<class Policy>
+template<class Policy, template<class, class> class Allocator>
 Ptr<Entry>
-ContentStoreImpl<Policy>::End()
+ContentStoreImpl<Policy, Allocator>::End()
 {
   return 0;
 }
 
-template<class Policy>
+template<class Policy, template<class, class> class Allocator>
 Ptr<Entry>
-ContentStoreImpl<Policy>::Next(Ptr<Entry> from)
+ContentStoreImpl<Policy, Allocator>::Next(Ptr<Entry> from)
 {
   if (from == 0)
     return 0;
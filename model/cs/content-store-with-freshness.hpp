@@ -161,6 +161,7 @@ ContentStoreWithFreshness<Policy>::CleanExpired()
     else
       break; // nothing else to do. All later records will not be stale
   }
+  this->m_occupiedBytes = this->get_bytes();
   // NS_LOG_LOGIC ("<< Cleaning: Total number of items:" << this->getPolicy ().size () << ", items
   // with freshness: " << freshness.size ());
 
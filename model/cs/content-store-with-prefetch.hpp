@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONTENT_STORE_WITH_PREFETCH_H_
+#define NDN_CONTENT_STORE_WITH_PREFETCH_H_
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "content-store-impl.hpp"
+#include "speculative-requests.hpp"
+
+#include "../../utils/trie/multi-policy.hpp"
+#include "custom-policies/prefetch-class-policy.hpp"
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+/**
+ * @ingroup ndn-cs
+ * @brief Special content store realization that keeps speculatively prefetched Data in a
+ *        separate eviction class
+ *
+ * The store is also the SpeculativeRequests record of its node: Data registered there is cached
+ * as speculative.  Speculative entries that have never been hit are evicted before any demand
+ * entry; the first hit promotes an entry to the demand class, where it is managed by the
+ * replacement policy @p Policy.  Speculative entries removed before their first hit are
+ * reported as wasted prefetches.
+ */
+template<class Policy>
+class ContentStoreWithPrefetch
+  : public ContentStoreImpl<ndnSIM::
+                              multi_policy_traits<boost::mpl::
+                                                    vector2<Policy,
+                                                            ndnSIM::
+                                                              prefetch_class_policy_traits>>>,
+    public SpeculativeRequests {
+public:
+  typedef ContentStoreImpl<ndnSIM::
+                             multi_policy_traits<boost::mpl::
+                                                   vector2<Policy,
+                                                           ndnSIM::prefetch_class_policy_traits>>>
+    super;
+
+  typedef typename super::policy_container::template index<1>::type prefetch_class_container;
+
+  ContentStoreWithPrefetch()
+  {
+    // connect the record and traces to the policy
+    super::getPolicy().template get<1>().set_speculative_requests(this);
+    super::getPolicy().template get<1>().set_traced_callbacks(&m_prefetchHit, &m_prefetchWasted);
+  }
+
+  static TypeId
+  GetTypeId();
+
+  virtual inline void
+  Print(std::ostream& os) const;
+
+  /**
+   * @brief Get number of Data packets cached as speculative
+   */
+  uint64_t
+  GetNSpeculative() const
+  {
+    return this->getPolicy().template get<1>().get_speculative_count();
+  }
+
+  /**
+   * @brief Get number of speculative entries that were hit at least once
+   */
+  uint64_t
+  GetNPrefetchHits() const
+  {
+    return this->getPolicy().template get<1>().get_hit_count();
+  }
+
+  /**
+   * @brief Get number of speculative entries that were evicted (or not admitted) without a hit
+   */
+  uint64_t
+  GetNPrefetchWasted() const
+  {
+    return this->getPolicy().template get<1>().get_wasted_count();
+  }
+
+private:
+  static LogComponent g_log; ///< @brief Logging variable
+
+  /// @brief trace of the first hit of a speculative entry
+  TracedCallback<Ptr<const Entry>> m_prefetchHit;
+
+  /// @brief trace of removal of a speculative entry that has never been hit
+  TracedCallback<Ptr<const Entry>> m_prefetchWasted;
+};
+
+//////////////////////////////////////////
+////////// Implementation ////////////////
+//////////////////////////////////////////
+
+template<class Policy>
+LogComponent ContentStoreWithPrefetch<Policy>::g_log = LogComponent(("ndn.cs.Prefetch."
+                                                                     + Policy::GetName()).c_str(), __FILE__);
+
+template<class Policy>
+TypeId
+ContentStoreWithPrefetch<Policy>::GetTypeId()
+{
+  static TypeId tid =
+    TypeId(("ns3::ndn::cs::Prefetch::" + Policy::GetName()).c_str())
+      .SetGroupName("Ndn")
+      .SetParent<super>()
+      .template AddConstructor<ContentStoreWithPrefetch<Policy>>()
+
+      .AddTraceSource("PrefetchHit", "Speculatively fetched entry is hit for the first time",
+                      MakeTraceSourceAccessor(&ContentStoreWithPrefetch<Policy>::m_prefetchHit),
+                      "ns3::ndn::cs::ContentStoreImpl::CsEntryCallback")
+
+      .AddTraceSource("PrefetchWasted",
+                      "Speculatively fetched entry is removed without being hit",
+                      MakeTraceSourceAccessor(&ContentStoreWithPrefetch<Policy>::m_prefetchWasted),
+                      "ns3::ndn::cs::ContentStoreImpl::CsEntryCallback");
+
+  return tid;
+}
+
+template<class Policy>
+void
+ContentStoreWithPrefetch<Policy>::Print(std::ostream& os) const
+{
+  for (typename super::policy_container::const_iterator item = this->getPolicy().begin();
+       item != this->getPolicy().end(); item++) {
+    os << item->payload()->GetName();
+    if (prefetch_class_container::policy_base::get_speculative(&(*item))) {
+      os << " (speculative)";
+    }
+    os << std::endl;
+  }
+}
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONTENT_STORE_WITH_PREFETCH_H_
@@ -0,0 +1,267 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef PREFETCH_CLASS_POLICY_H_
+#define PREFETCH_CLASS_POLICY_H_
+
+/// @cond include_hidden
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/cs/speculative-requests.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <ns3/traced-callback.h>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for prefetch class policy
+ *
+ * Splits entries into demand and speculative classes at insertion time, according to the
+ * cs::SpeculativeRequests record given to set_speculative_requests (all entries are demand
+ * entries without one).  Speculative entries that have not been hit yet are evicted first,
+ * in insertion order, and become regular demand entries on their first hit.  The policy is
+ * meant to be combined with a regular replacement policy through multi_policy_traits, placed
+ * after it: its insert runs first and only frees space occupied by never-hit speculative
+ * entries, the rest is left to the replacement policy.
+ */
+struct prefetch_class_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "PrefetchClass";
+  }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    bool speculative; ///< @brief true until the first hit of a speculatively fetched entry
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    typedef typename boost::intrusive::list<Container, Hook> policy_container;
+
+    static bool&
+    get_speculative(typename Container::iterator item)
+    {
+      return static_cast<typename policy_container::value_traits::hook_type*>(
+               policy_container::value_traits::to_node_ptr(*item))->speculative;
+    }
+
+    static const bool&
+    get_speculative(typename Container::const_iterator item)
+    {
+      return static_cast<const typename policy_container::value_traits::hook_type*>(
+               policy_container::value_traits::to_node_ptr(*item))->speculative;
+    }
+
+    class type : public policy_container {
+    public:
+      typedef policy policy_base; // to get access to get_speculative methods from outside
+      typedef Container parent_trie;
+      typedef TracedCallback<typename parent_trie::payload_traits::const_base_type>
+        traced_callback;
+
+      type(Base& base)
+        : base_(base)
+        , max_size_(100)
+        , max_bytes_(0)
+        , speculative_(0)
+        , hits_(0)
+        , wasted_(0)
+        , requests_(0)
+        , m_prefetchHit(0)
+        , m_prefetchWasted(0)
+      {
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        // do nothing
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        bool speculative =
+          requests_ != 0 && requests_->IsSpeculative(item->payload()->GetName());
+        get_speculative(item) = speculative;
+        if (speculative)
+          speculative_++;
+
+        size_t bytes = Base::s_payload_size(item);
+        if (max_bytes_ != 0 && bytes > max_bytes_) {
+          if (speculative)
+            waste(item);
+          return false;
+        }
+
+        while (!policy_container::empty() && is_full(bytes)) {
+          base_.erase(&(*policy_container::begin()));
+        }
+
+        if (speculative)
+          policy_container::push_back(*item);
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        if (!get_speculative(item))
+          return;
+
+        // promote to demand class
+        get_speculative(item) = false;
+        policy_container::erase(policy_container::s_iterator_to(*item));
+        hits_++;
+        if (m_prefetchHit != 0) {
+          (*m_prefetchHit)(item->payload());
+        }
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        if (!get_speculative(item))
+          return;
+
+        policy_container::erase(policy_container::s_iterator_to(*item));
+        waste(item);
+      }
+
+      inline void
+      clear()
+      {
+        policy_container::clear();
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        max_size_ = max_size;
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_size_;
+      }
+
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+
+      /// @brief Number of entries classified as speculative on insertion
+      uint64_t
+      get_speculative_count() const
+      {
+        return speculative_;
+      }
+
+      /// @brief Number of speculative entries that were hit (and promoted to demand class)
+      uint64_t
+      get_hit_count() const
+      {
+        return hits_;
+      }
+
+      /// @brief Number of speculative entries removed or rejected before their first hit
+      uint64_t
+      get_wasted_count() const
+      {
+        return wasted_;
+      }
+
+      void
+      set_speculative_requests(const cs::SpeculativeRequests* requests)
+      {
+        requests_ = requests;
+      }
+
+      void
+      set_traced_callbacks(traced_callback* prefetchHit, traced_callback* prefetchWasted)
+      {
+        m_prefetchHit = prefetchHit;
+        m_prefetchWasted = prefetchWasted;
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+      bool
+      is_full(size_t bytes) const
+      {
+        // size of the whole content store, the entry being inserted is not counted yet
+        return (max_size_ != 0 && base_.getPolicy().size() >= max_size_)
+               || (max_bytes_ != 0 && base_.get_bytes() + bytes > max_bytes_);
+      }
+
+      void
+      waste(typename parent_trie::iterator item)
+      {
+        wasted_++;
+        if (m_prefetchWasted != 0) {
+          (*m_prefetchWasted)(item->payload());
+        }
+      }
+
+    private:
+      Base& base_;
+      size_t max_size_;
+      size_t max_bytes_;
+
+      uint64_t speculative_;
+      uint64_t hits_;
+      uint64_t wasted_;
+
+      const cs::SpeculativeRequests* requests_;
+      traced_callback* m_prefetchHit;
+      traced_callback* m_prefetchWasted;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // PREFETCH_CLASS_POLICY_H_
@@ -64,6 +64,7 @@ struct probability_policy_traits {
       type(Base& base)
         : base_(base)
         , max_size_(100)
+        , max_bytes_(0)
         , probability_(1.0)
         , ns3_rand_(CreateObject<UniformRandomVariable>())
       {
@@ -119,6 +120,18 @@ struct probability_policy_traits {
         return max_size_;
       }
 
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+
       inline void
       set_probability(double probability)
       {
@@ -138,6 +151,7 @@ struct probability_policy_traits {
     private:
       Base& base_;
       size_t max_size_;
+      size_t max_bytes_;
       double probability_;
       Ptr<UniformRandomVariable> ns3_rand_;
     };
@@ -59,6 +59,8 @@ namespace cs {
 Entry::Entry(Ptr<ContentStore> cs, shared_ptr<const Data> data)
   : m_cs(cs)
   , m_data(data)
+  , m_size(data->hasWire() ? data->wireEncode().size()
+                           : data->getName().wireEncode().size() + data->getContent().size())
 {
 }
 
@@ -74,6 +76,12 @@ Entry::GetData() const
   return m_data;
 }
 
+size_t
+Entry::GetSize() const
+{
+  return m_size;
+}
+
 Ptr<ContentStore>
 Entry::GetContentStore()
 {
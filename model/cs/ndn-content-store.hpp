@@ -78,6 +78,15 @@ public:
   shared_ptr<const Data>
   GetData() const;
 
+  /**
+   * \brief Get size of the stored Data, in bytes
+   *
+   * This is the wire size of the Data packet, or an estimate from its name and content if the
+   * packet has not been encoded.
+   */
+  size_t
+  GetSize() const;
+
   /**
    * @brief Get pointer to access store, to which this entry is added
    */
@@ -87,6 +96,7 @@ public:
 private:
   Ptr<ContentStore> m_cs;        ///< \brief content store to which entry is added
   shared_ptr<const Data> m_data; ///< \brief non-modifiable Data
+  size_t m_size;                 ///< \brief cached size of m_data
 };
 
 } // namespace cs
@@ -119,6 +129,9 @@ public:
    *
    * If an entry is found, it is promoted to the top of most recent
    * used entries index, \see m_contentStore
+   *
+   * \returns a copy of the cached Data, which the caller (e.g., the forwarder, which attaches
+   *          tags to it) may modify, or nullptr on a miss
    */
   virtual shared_ptr<Data>
   Lookup(shared_ptr<const Interest> interest) = 0;
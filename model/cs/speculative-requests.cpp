@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "speculative-requests.hpp"
+#include "ndn-content-store.hpp"
+
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+SpeculativeRequests*
+SpeculativeRequests::Get(Ptr<Node> node)
+{
+  Ptr<ContentStore> contentStore = node->GetObject<ContentStore>();
+  if (contentStore == nullptr) {
+    return nullptr;
+  }
+  return dynamic_cast<SpeculativeRequests*>(PeekPointer(contentStore));
+}
+
+void
+SpeculativeRequests::Register(const Name& name, Time lifetime)
+{
+  Purge();
+
+  Time expires = Simulator::Now() + lifetime;
+  Time& record = m_expires[name];
+  if (record < expires) {
+    record = expires;
+    m_timeline.insert(std::make_pair(expires, name));
+  }
+}
+
+bool
+SpeculativeRequests::IsSpeculative(const Name& name) const
+{
+  auto record = m_expires.find(name);
+  return record != m_expires.end() && Simulator::Now() < record->second;
+}
+
+void
+SpeculativeRequests::Purge()
+{
+  Time now = Simulator::Now();
+  while (!m_timeline.empty() && m_timeline.begin()->first <= now) {
+    auto record = m_expires.find(m_timeline.begin()->second);
+    if (record != m_expires.end() && record->second <= now) {
+      m_expires.erase(record);
+    }
+    m_timeline.erase(m_timeline.begin());
+  }
+}
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
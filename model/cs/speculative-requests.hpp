@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_CS_SPECULATIVE_REQUESTS_H_
+#define NDN_CS_SPECULATIVE_REQUESTS_H_
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <map>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+namespace cs {
+
+/**
+ * @ingroup ndn-cs
+ * @brief Record of Data names that a node expects to cache because of speculative requests
+ *
+ * Prefetched segments carry the same names as segments requested on demand, so content stores
+ * cannot tell them apart by looking at the Data packet.  Content stores with prefetch classes
+ * (ns3::ndn::cs::Prefetch::*) derive from this class and consult their own record when Data
+ * is cached; nodes with any other content store have no record at all, and Get returns nullptr
+ * for them.
+ *
+ * A prefetching application registers the names it is about to pull only at the node where
+ * the prefetched Data is meant to be used, e.g., PrefetcherNode registers them at the AP it is
+ * associated with.  A record expires after the given lifetime.
+ */
+class SpeculativeRequests {
+public:
+  /**
+   * @brief Get the record of the content store installed on @p node
+   * @returns nullptr if the content store of the node does not have prefetch classes
+   */
+  static SpeculativeRequests*
+  Get(Ptr<Node> node);
+
+  /**
+   * @brief Record that Data @p name is expected to arrive within @p lifetime because of a
+   *        speculative request
+   */
+  void
+  Register(const Name& name, Time lifetime);
+
+  /**
+   * @brief Check whether Data @p name has been requested speculatively and the request has not
+   *        expired yet
+   */
+  bool
+  IsSpeculative(const Name& name) const;
+
+protected:
+  virtual
+  ~SpeculativeRequests() = default;
+
+private:
+  void
+  Purge();
+
+private:
+  std::map<Name, Time> m_expires;       ///< @brief expiration time of each record
+  std::multimap<Time, Name> m_timeline; ///< @brief records ordered by expiration (may be stale)
+};
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CS_SPECULATIVE_REQUESTS_H_
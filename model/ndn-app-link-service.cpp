@@ -44,6 +44,9 @@ AppLinkService::AppLinkService(Ptr<App> app)
 AppLinkService::~AppLinkService()
 {
   NS_LOG_FUNCTION_NOARGS();
+
+  // the app has stopped, so it would ignore the remaining packets anyway
+  m_drainEvent.Cancel();
 }
 
 void
@@ -51,8 +54,7 @@ AppLinkService::doSendInterest(const Interest& interest)
 {
   NS_LOG_FUNCTION(this << &interest);
 
-  // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnInterest, m_app, interest.shared_from_this());
+  enqueue(interest.shared_from_this(), nullptr, nullptr);
 }
 
 void
@@ -60,8 +62,7 @@ AppLinkService::doSendData(const Data& data)
 {
   NS_LOG_FUNCTION(this << &data);
 
-  // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this());
+  enqueue(nullptr, data.shared_from_this(), nullptr);
 }
 
 void
@@ -69,8 +70,42 @@ AppLinkService::doSendNack(const lp::Nack& nack)
 {
   NS_LOG_FUNCTION(this << &nack);
 
-  // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnNack, m_app, make_shared<lp::Nack>(nack));
+  enqueue(nullptr, nullptr, make_shared<lp::Nack>(nack));
+}
+
+void
+AppLinkService::enqueue(shared_ptr<const Interest> interest, shared_ptr<const Data> data,
+                        shared_ptr<lp::Nack> nack)
+{
+  // to decouple callbacks, packets are delivered from a separate event; a burst of packets
+  // shares a single event
+  if (m_queue.empty()) {
+    m_drainEvent = Simulator::ScheduleNow(&AppLinkService::drain, this);
+  }
+  m_queue.push_back({std::move(interest), std::move(data), std::move(nack)});
+}
+
+void
+AppLinkService::drain()
+{
+  NS_LOG_FUNCTION(this << m_queue.size());
+
+  // packets sent to the app while it processes this batch go to the next drain event, as
+  // they would have been scheduled after the packets of this batch
+  std::deque<Delivery> batch;
+  batch.swap(m_queue);
+
+  for (auto& delivery : batch) {
+    if (delivery.interest != nullptr) {
+      m_app->OnInterest(std::move(delivery.interest));
+    }
+    else if (delivery.data != nullptr) {
+      m_app->OnData(std::move(delivery.data));
+    }
+    else {
+      m_app->OnNack(std::move(delivery.nack));
+    }
+  }
 }
 
 //
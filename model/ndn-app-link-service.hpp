@@ -23,6 +23,10 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/NFD/daemon/face/link-service.hpp"
 
+#include "ns3/event-id.h"
+
+#include <deque>
+
 namespace ns3 {
 
 class Packet;
@@ -36,6 +40,14 @@ class App;
  * \ingroup ndn-face
  * \brief Implementation of LinkService for ndnSIM application
  *
+ * To decouple the callbacks of the app from the forwarder, packets are delivered from a
+ * separate event at the time they were sent.  Packets sent before this event runs share it
+ * and reach the app in the order they were sent, exactly as with one event per packet.  The
+ * only difference is that such a burst is no longer interleaved with other events scheduled
+ * for the same time between its first and last packet, which run after the whole burst
+ * instead.  The simulated time of every delivery is unchanged, while saving an event per
+ * packet matters for apps receiving many packets at a time.
+ *
  * \see NetDeviceLinkService
  */
 class AppLinkService : public nfd::face::LinkService
@@ -75,9 +87,33 @@ private:
     BOOST_ASSERT(false);
   }
 
+  /**
+   * \brief Add packet to the delivery queue, scheduling its drain if the queue was empty
+   */
+  void
+  enqueue(shared_ptr<const Interest> interest, shared_ptr<const Data> data,
+          shared_ptr<lp::Nack> nack);
+
+  /**
+   * \brief Deliver all packets that were queued before the drain started, in order
+   */
+  void
+  drain();
+
 private:
   Ptr<Node> m_node;
   Ptr<App> m_app;
+
+  /// \brief packet to be delivered to the app, exactly one of the pointers is set
+  struct Delivery
+  {
+    shared_ptr<const Interest> interest;
+    shared_ptr<const Data> data;
+    shared_ptr<lp::Nack> nack;
+  };
+
+  std::deque<Delivery> m_queue;
+  EventId m_drainEvent;
 };
 
 } // namespace ndn
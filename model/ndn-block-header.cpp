@@ -19,16 +19,11 @@
 
 #include "ndn-block-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
-
 #include <ndn-cxx/encoding/tlv.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/lp/packet.hpp>
 
-namespace io = boost::iostreams;
 namespace nfdFace = nfd::face;
 
 namespace ns3 {
@@ -73,37 +68,55 @@ BlockHeader::Serialize(ns3::Buffer::Iterator start) const
   start.Write(m_block.wire(), m_block.size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
+/**
+ * @brief Read TLV-TYPE or TLV-LENGTH number from ns3::Buffer
+ */
+static uint64_t
+readVarNumber(ns3::Buffer::Iterator& is)
+{
+  if (is.GetRemainingSize() < 1) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Insufficient data during TLV parsing"));
   }
 
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
+  uint8_t firstOctet = is.ReadU8();
+  if (firstOctet < 253) {
+    return firstOctet;
+  }
+
+  uint32_t size = firstOctet == 253 ? 2 : (firstOctet == 254 ? 4 : 8);
+  if (is.GetRemainingSize() < size) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Insufficient data during TLV parsing"));
   }
 
-private:
-  ns3::Buffer::Iterator& m_is;
-};
+  switch (size) {
+  case 2:
+    return is.ReadNtohU16();
+  case 4:
+    return is.ReadNtohU32();
+  default:
+    return is.ReadNtohU64();
+  }
+}
 
 uint32_t
 BlockHeader::Deserialize(ns3::Buffer::Iterator start)
 {
-  io::stream<Ns3BufferIteratorSource> is(start);
-  m_block = ::ndn::Block::fromStream(is);
+  // parse TLV-TYPE and TLV-LENGTH in place, then copy the whole TLV in one go
+  ns3::Buffer::Iterator is = start;
+  readVarNumber(is);
+  uint64_t length = readVarNumber(is);
+  if (length > ::ndn::MAX_NDN_PACKET_SIZE) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("TLV-LENGTH from stream exceeds limit"));
+  }
+
+  uint32_t headerSize = is.GetDistanceFrom(start);
+  if (is.GetRemainingSize() < length) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Not enough data in the buffer to fully parse TLV"));
+  }
+
+  auto buffer = make_shared< ::ndn::Buffer>(headerSize + length);
+  start.Read(buffer->data(), buffer->size());
+  m_block = Block(buffer);
   return m_block.size();
 }
 
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-block-tag.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/global-value.h"
+
+#include <deque>
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+GlobalValue g_blockLifetime("NdnBlockLifetime",
+                            "For how long blocks of in-memory NDN packets stay available to the "
+                            "receivers",
+                            TimeValue(Seconds(1)), MakeTimeChecker());
+
+/**
+ * @brief Blocks in flight, indexed by consecutive identifiers in creation order
+ */
+struct BlockTable
+{
+  uint64_t firstId = 0;
+  std::deque<std::pair<Time, Block>> blocks; ///< expiration time and block
+  Time lifetime = Seconds(1);
+  bool isResetScheduled = false;
+};
+
+BlockTable g_blockTable;
+
+void
+resetBlockTable()
+{
+  g_blockTable = BlockTable();
+}
+
+BlockTable&
+getBlockTable()
+{
+  if (!g_blockTable.isResetScheduled) {
+    // blocks must not outlive the simulation, nor leak into the next one
+    Simulator::ScheduleDestroy(&resetBlockTable);
+    g_blockTable.isResetScheduled = true;
+
+    TimeValue lifetime;
+    g_blockLifetime.GetValue(lifetime);
+    g_blockTable.lifetime = lifetime.Get();
+  }
+  return g_blockTable;
+}
+
+} // namespace
+
+NS_OBJECT_ENSURE_REGISTERED(BlockTag);
+
+TypeId
+BlockTag::GetTypeId()
+{
+  static TypeId tid = TypeId("ns3::ndn::BlockTag")
+    .SetGroupName("Ndn")
+    .SetParent<Tag>()
+    .AddConstructor<BlockTag>()
+    ;
+  return tid;
+}
+
+TypeId
+BlockTag::GetInstanceTypeId() const
+{
+  return GetTypeId();
+}
+
+BlockTag::BlockTag()
+  : m_id(0)
+{
+}
+
+Ptr<ns3::Packet>
+BlockTag::CreatePacket(const Block& block)
+{
+  BlockTable& table = getBlockTable();
+  Time now = Simulator::Now();
+
+  // ids are assigned in creation order, so expired blocks are always at the front
+  while (!table.blocks.empty() && table.blocks.front().first < now) {
+    table.blocks.pop_front();
+    table.firstId++;
+  }
+
+  BlockTag tag;
+  tag.m_id = table.firstId + table.blocks.size();
+  table.blocks.emplace_back(now + table.lifetime, block);
+
+  Ptr<ns3::Packet> packet = Create<ns3::Packet>(block.size());
+  packet->AddPacketTag(tag);
+  return packet;
+}
+
+Time
+BlockTag::GetLifetime()
+{
+  return getBlockTable().lifetime;
+}
+
+const Block*
+BlockTag::GetBlock() const
+{
+  const BlockTable& table = getBlockTable();
+  if (m_id < table.firstId || m_id - table.firstId >= table.blocks.size()
+      || table.blocks[m_id - table.firstId].first < Simulator::Now()) {
+    return nullptr;
+  }
+
+  return &table.blocks[m_id - table.firstId].second;
+}
+
+uint32_t
+BlockTag::GetSerializedSize() const
+{
+  return sizeof(m_id);
+}
+
+void
+BlockTag::Serialize(TagBuffer i) const
+{
+  i.WriteU64(m_id);
+}
+
+void
+BlockTag::Deserialize(TagBuffer i)
+{
+  m_id = i.ReadU64();
+}
+
+void
+BlockTag::Print(std::ostream& os) const
+{
+  os << "BlockId=" << m_id;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_NDN_BLOCK_TAG_HPP
+#define NDNSIM_NDN_BLOCK_TAG_HPP
+
+#include "ns3/tag.h"
+#include "ns3/packet.h"
+#include "ns3/nstime.h"
+
+#include "ndn-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Packet tag that carries an ndn::Block by reference instead of by value
+ *
+ * In the in-memory packet mode, NetDeviceTransport sends an ns3::Packet consisting of
+ * Block::size() virtual (zero-filled, unallocated) bytes and this tag.  The tag only stores an
+ * identifier of the block in a process-wide table, so neither the sender nor the receivers
+ * copy or parse any bytes, while all lower layers still see the true wire size of the packet.
+ *
+ * The table keeps a block for a fixed lifetime after the packet was created, as ns-3 gives no
+ * way to learn when the last copy of the ns3::Packet is gone.  The lifetime is the global value
+ * NdnBlockLifetime (1 second by default, e.g., `Config::SetGlobal("NdnBlockLifetime",
+ * TimeValue(Seconds(5)))` or `--NdnBlockLifetime=5s`), read when the first packet of a
+ * simulation is created.  It should exceed the longest time a frame can spend in device queues
+ * and channels: the block of a packet delivered later is gone, and the receiver drops the
+ * packet (see GetBlock).  The table is emptied on Simulator::Destroy.
+ */
+class BlockTag : public Tag {
+public:
+  static TypeId
+  GetTypeId();
+
+  virtual TypeId
+  GetInstanceTypeId() const;
+
+  BlockTag();
+
+  /**
+   * @brief Create ns3::Packet of the size of @p block that refers to @p block
+   */
+  static Ptr<ns3::Packet>
+  CreatePacket(const Block& block);
+
+  /**
+   * @brief Get the referred block, or nullptr if it has already expired
+   */
+  const Block*
+  GetBlock() const;
+
+  /**
+   * @brief Get for how long blocks of the current simulation stay available to the receivers
+   */
+  static Time
+  GetLifetime();
+
+  virtual uint32_t
+  GetSerializedSize() const;
+
+  virtual void
+  Serialize(TagBuffer i) const;
+
+  virtual void
+  Deserialize(TagBuffer i);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+private:
+  uint64_t m_id;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_NDN_BLOCK_TAG_HPP
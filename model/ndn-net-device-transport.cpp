@@ -21,12 +21,22 @@
 
 #include "../helper/ndn-stack-helper.hpp"
 #include "ndn-block-header.hpp"
+#include "ndn-block-tag.hpp"
 #include "../utils/ndn-ns3-packet-tag.hpp"
 
+#include "ns3/ndnSIM/NFD/daemon/face/face.hpp"
+
+#include "ns3/wifi-net-device.h"
+#include "ns3/ap-wifi-mac.h"
+
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+
 NS_LOG_COMPONENT_DEFINE("ndn.NetDeviceTransport");
 
 namespace ns3 {
@@ -41,6 +51,9 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
                                        ::ndn::nfd::LinkType linkType)
   : m_netDevice(netDevice)
   , m_node(node)
+  , m_inMemoryPackets(false)
+  , m_unicast(false)
+  , m_isStaAssociated(false)
 {
   this->setLocalUri(FaceUri(localUri));
   this->setRemoteUri(FaceUri(remoteUri));
@@ -59,9 +72,35 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
                                   true /*promiscuous mode*/);
 }
 
+NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
+                                       const Ptr<NetDevice>& netDevice,
+                                       const std::string& localUri,
+                                       const Mac48Address& neighbor)
+  : m_netDevice(netDevice)
+  , m_node(node)
+  , m_inMemoryPackets(false)
+  , m_unicast(false)
+  , m_isStaAssociated(false)
+  , m_remoteAddress(neighbor)
+{
+  this->setLocalUri(FaceUri(localUri));
+  this->setRemoteUri(FaceUri("netdev://[" + boost::lexical_cast<std::string>(neighbor) + "]"));
+  this->setScope(::ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  this->setPersistency(::ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
+  this->setLinkType(::ndn::nfd::LINK_TYPE_POINT_TO_POINT);
+  this->setMtu(m_netDevice->GetMtu());
+
+  NS_LOG_FUNCTION(this << "Creating an ndnSIM transport instance to neighbor" << neighbor
+                  << "for netDevice with URI" << this->getLocalUri());
+
+  // frames are delivered by the multi-access transport of the same device
+}
+
 NetDeviceTransport::~NetDeviceTransport()
 {
   NS_LOG_FUNCTION_NOARGS();
+  m_neighborCheckEvent.Cancel();
+  SetUnicast(false);
 }
 
 void
@@ -70,6 +109,14 @@ NetDeviceTransport::doClose()
   NS_LOG_FUNCTION(this << "Closing transport for netDevice with URI"
                   << this->getLocalUri());
 
+  m_neighborCheckEvent.Cancel();
+  auto neighborFaces = std::move(m_neighborFaces);
+  for (auto& neighbor : neighborFaces) {
+    if (auto face = neighbor.second.face.lock()) {
+      face->close();
+    }
+  }
+
   // set the state of the transport to "CLOSED"
   this->setState(nfd::face::TransportState::CLOSED);
 }
@@ -80,15 +127,35 @@ NetDeviceTransport::doSend(Packet&& packet)
   NS_LOG_FUNCTION(this << "Sending packet from netDevice with URI"
                   << this->getLocalUri());
 
-  // convert NFD packet to NS3 packet
-  BlockHeader header(packet);
+  Ptr<ns3::Packet> ns3Packet;
+  if (m_inMemoryPackets) {
+    ns3Packet = BlockTag::CreatePacket(packet.packet);
+  }
+  else {
+    // convert NFD packet to NS3 packet
+    BlockHeader header(packet);
 
-  Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
-  ns3Packet->AddHeader(header);
+    ns3Packet = Create<ns3::Packet>();
+    ns3Packet->AddHeader(header);
+  }
 
   // send the NS3 packet
-  m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
-                    L3Protocol::ETHERNET_FRAME_TYPE);
+  m_netDevice->Send(ns3Packet, GetNextHop(), L3Protocol::ETHERNET_FRAME_TYPE);
+}
+
+Address
+NetDeviceTransport::GetNextHop()
+{
+  if (!m_remoteAddress.IsInvalid()) {
+    return m_remoteAddress;
+  }
+
+  if (m_staMac != nullptr && m_isStaAssociated) {
+    return m_staMac->GetBssid();
+  }
+
+  // an AP reaches individual STAs through their own faces
+  return m_netDevice->GetBroadcast();
 }
 
 // callback
@@ -101,6 +168,35 @@ NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
 {
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
+  if (m_createNeighborFace &&
+      (m_apStations == nullptr || isAssociated(Mac48Address::ConvertFrom(from)))) {
+    NetDeviceTransport* neighbor = touchNeighbor(Mac48Address::ConvertFrom(from));
+    // frames unicast to this node belong to the neighbor's face, everything else (broadcast
+    // and overheard frames) to the multi-access face
+    if (neighbor != nullptr && packetType == NetDevice::PACKET_HOST) {
+      neighbor->receivePacket(p);
+      return;
+    }
+  }
+
+  receivePacket(p);
+}
+
+void
+NetDeviceTransport::receivePacket(Ptr<const ns3::Packet> p)
+{
+  BlockTag tag;
+  if (p->PeekPacketTag(tag)) {
+    const Block* block = tag.GetBlock();
+    if (block == nullptr) {
+      NS_LOG_WARN("Dropping in-memory packet delayed for more than "
+                  << BlockTag::GetLifetime().GetSeconds() << "s, increase NdnBlockLifetime");
+      return;
+    }
+    this->receive(Packet(*block));
+    return;
+  }
+
   // Convert NS3 packet to NFD packet
   Ptr<ns3::Packet> packet = p->Copy();
 
@@ -112,11 +208,167 @@ NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
   this->receive(std::move(nfdPacket));
 }
 
+void
+NetDeviceTransport::EnableNeighborFaces(const NeighborFaceCreateCallback& createFace,
+                                        Time neighborTimeout)
+{
+  m_createNeighborFace = createFace;
+  m_neighborTimeout = neighborTimeout;
+}
+
+NetDeviceTransport*
+NetDeviceTransport::touchNeighbor(const Mac48Address& address)
+{
+  auto it = m_neighborFaces.find(address);
+  if (it != m_neighborFaces.end()) {
+    auto face = it->second.face.lock();
+    if (face != nullptr && face->getState() != nfd::face::FaceState::CLOSED) {
+      it->second.lastHeard = Simulator::Now();
+      return static_cast<NetDeviceTransport*>(face->getTransport());
+    }
+    // the face was closed by someone else, start over
+    m_neighborFaces.erase(it);
+  }
+
+  shared_ptr<Face> face = m_createNeighborFace(address);
+  if (face == nullptr) {
+    return nullptr;
+  }
+  NS_LOG_DEBUG("New neighbor " << address << " on " << this->getLocalUri() << ", face "
+               << face->getId());
+
+  m_neighborFaces[address] = {face, Simulator::Now()};
+  if (!m_neighborCheckEvent.IsRunning()) {
+    m_neighborCheckEvent = Simulator::Schedule(m_neighborTimeout,
+                                               &NetDeviceTransport::checkNeighbors, this);
+  }
+  return static_cast<NetDeviceTransport*>(face->getTransport());
+}
+
+void
+NetDeviceTransport::checkNeighbors()
+{
+  Time now = Simulator::Now();
+  Time nextCheck = Time::Max();
+
+  for (auto it = m_neighborFaces.begin(); it != m_neighborFaces.end();) {
+    if (std::find(m_associated.begin(), m_associated.end(), it->first) != m_associated.end()) {
+      // STAs are kept while associated
+      it->second.lastHeard = now;
+    }
+
+    Time expiry = it->second.lastHeard + m_neighborTimeout;
+    if (expiry <= now) {
+      NS_LOG_DEBUG("Lost neighbor " << it->first << " on " << this->getLocalUri());
+      auto face = it->second.face.lock();
+      it = m_neighborFaces.erase(it);
+      if (face != nullptr) {
+        face->close();
+      }
+    }
+    else {
+      nextCheck = std::min(nextCheck, expiry);
+      ++it;
+    }
+  }
+
+  if (!m_neighborFaces.empty()) {
+    m_neighborCheckEvent = Simulator::Schedule(nextCheck - now,
+                                               &NetDeviceTransport::checkNeighbors, this);
+  }
+}
+
 Ptr<NetDevice>
 NetDeviceTransport::GetNetDevice() const
 {
   return m_netDevice;
 }
 
+void
+NetDeviceTransport::SetInMemoryPackets(bool enable)
+{
+  m_inMemoryPackets = enable;
+}
+
+void
+NetDeviceTransport::SetUnicast(bool enable)
+{
+  if (m_staMac != nullptr) {
+    m_staMac->TraceDisconnectWithoutContext("Assoc",
+                                            MakeCallback(&NetDeviceTransport::onStaAssoc, this));
+    m_staMac->TraceDisconnectWithoutContext("DeAssoc",
+                                            MakeCallback(&NetDeviceTransport::onStaDeAssoc, this));
+  }
+
+  m_unicast = enable;
+  m_staMac = nullptr;
+  m_isStaAssociated = false;
+  m_apStations = nullptr;
+
+  Ptr<WifiNetDevice> wifiDev = DynamicCast<WifiNetDevice>(m_netDevice);
+  if (!m_unicast || wifiDev == nullptr) {
+    return;
+  }
+
+  m_staMac = DynamicCast<StaWifiMac>(wifiDev->GetMac());
+  if (m_staMac != nullptr) {
+    m_staMac->TraceConnectWithoutContext("Assoc",
+                                         MakeCallback(&NetDeviceTransport::onStaAssoc, this));
+    m_staMac->TraceConnectWithoutContext("DeAssoc",
+                                         MakeCallback(&NetDeviceTransport::onStaDeAssoc, this));
+    // the STA may have associated before the traces got connected
+    m_isStaAssociated = m_staMac->IsAssociated();
+  }
+  if (DynamicCast<ApWifiMac>(wifiDev->GetMac()) != nullptr) {
+    m_apStations = wifiDev->GetRemoteStationManager();
+  }
+}
+
+void
+NetDeviceTransport::SetAssociated(const Mac48Address& sta, bool isAssociated)
+{
+  NS_LOG_FUNCTION(this << sta << isAssociated);
+
+  m_associated.erase(std::remove(m_associated.begin(), m_associated.end(), sta),
+                     m_associated.end());
+  if (isAssociated) {
+    m_associated.push_back(sta);
+    if (m_createNeighborFace) {
+      touchNeighbor(sta);
+    }
+    return;
+  }
+
+  auto it = m_neighborFaces.find(sta);
+  if (it != m_neighborFaces.end()) {
+    NS_LOG_DEBUG("STA " << sta << " left " << this->getLocalUri());
+    auto face = it->second.face.lock();
+    m_neighborFaces.erase(it);
+    if (face != nullptr) {
+      face->close();
+    }
+  }
+}
+
+bool
+NetDeviceTransport::isAssociated(const Mac48Address& sta) const
+{
+  // the remote station manager learns about the association only at the end of the handshake
+  return m_apStations->IsAssociated(sta) ||
+         std::find(m_associated.begin(), m_associated.end(), sta) != m_associated.end();
+}
+
+void
+NetDeviceTransport::onStaAssoc(Mac48Address bssid)
+{
+  m_isStaAssociated = true;
+}
+
+void
+NetDeviceTransport::onStaDeAssoc(Mac48Address bssid)
+{
+  m_isStaAssociated = false;
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -28,9 +28,17 @@
 #include "ns3/packet.h"
 #include "ns3/node.h"
 #include "ns3/pointer.h"
+#include "ns3/event-id.h"
 
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
+#include "ns3/mac48-address.h"
+#include "ns3/sta-wifi-mac.h"
+#include "ns3/wifi-remote-station-manager.h"
+
+#include <functional>
+#include <map>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -49,11 +57,73 @@ public:
                      ::ndn::nfd::FacePersistency persistency = ::ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
                      ::ndn::nfd::LinkType linkType = ::ndn::nfd::LINK_TYPE_POINT_TO_POINT);
 
+  /**
+   * \brief Create transport to a single \p neighbor on a multi-access device
+   *
+   * Frames are sent unicast to \p neighbor.  The transport does not receive frames from the
+   * device by itself: they are handed over by the multi-access transport of the same device,
+   * which creates such transports through EnableNeighborFaces.
+   */
+  NetDeviceTransport(Ptr<Node> node, const Ptr<NetDevice>& netDevice,
+                     const std::string& localUri,
+                     const Mac48Address& neighbor);
+
   ~NetDeviceTransport();
 
   Ptr<NetDevice>
   GetNetDevice() const;
 
+  /**
+   * @brief Enable or disable the in-memory packet mode for outgoing packets
+   *
+   * When enabled, the NFD packet is not serialized into the ns3::Packet, but passed by
+   * reference in a BlockTag.  The ns3::Packet still has the size of the encoded packet, so
+   * the timing of the lower layers is unaffected, but pcap traces contain zeros instead of
+   * the NDN packets.  Incoming packets are accepted in either form.
+   */
+  void
+  SetInMemoryPackets(bool enable);
+
+  /**
+   * @brief Enable or disable unicast next-hop addressing on wifi devices
+   *
+   * By default, all packets are sent to the broadcast address, which on 802.11 means no MAC
+   * acknowledgements, no retransmissions and the NonUnicastMode rate.  When enabled, a STA
+   * sends to the BSSID of the AP while it is associated (and to the broadcast address, which
+   * the MAC drops, otherwise).  An AP has no single next hop: packets for a particular STA
+   * are sent unicast on the face of this STA (see EnableNeighborFaces), while this face keeps
+   * broadcasting to all of them.
+   *
+   * The setting has no effect on other devices.
+   */
+  void
+  SetUnicast(bool enable);
+
+  /**
+   * @brief Record that @p sta has associated with (or left) this AP
+   *
+   * If neighbor faces are enabled, the face of @p sta is created at once, without waiting for
+   * a frame from the STA, and kept while it stays associated, even if it is silent for longer
+   * than the neighbor timeout.  The face is closed when the STA is reported as gone.  Used by
+   * WifiAssociation.
+   */
+  void
+  SetAssociated(const Mac48Address& sta, bool isAssociated);
+
+  typedef std::function<shared_ptr<Face>(const Mac48Address& neighbor)> NeighborFaceCreateCallback;
+
+  /**
+   * @brief Maintain a per-neighbor face for every node heard on this multi-access transport
+   *
+   * The face of a neighbor is created by @p createFace when the first frame from it is
+   * received, and closed when nothing has been heard from it for @p neighborTimeout.  Frames
+   * unicast to this node from a known neighbor are received on the neighbor's face, while
+   * broadcast and overheard frames are still received on this face.  On an AP, only
+   * associated STAs get a face (see SetAssociated).
+   */
+  void
+  EnableNeighborFaces(const NeighborFaceCreateCallback& createFace, Time neighborTimeout);
+
 private:
   virtual void
   doClose() override;
@@ -61,6 +131,12 @@ private:
   virtual void
   doSend(Packet&& packet) override;
 
+  /**
+   * @brief Get link-layer destination of the next outgoing packet
+   */
+  Address
+  GetNextHop();
+
   void
   receiveFromNetDevice(Ptr<NetDevice> device,
                        Ptr<const ns3::Packet> p,
@@ -68,8 +144,56 @@ private:
                        const Address& from, const Address& to,
                        NetDevice::PacketType packetType);
 
+  void
+  receivePacket(Ptr<const ns3::Packet> p);
+
+  /**
+   * @brief Record that @p address has been heard, creating its face if needed
+   * @return transport of the neighbor's face, or nullptr if no face could be created
+   */
+  NetDeviceTransport*
+  touchNeighbor(const Mac48Address& address);
+
+  /**
+   * @brief Close faces of neighbors that have not been heard for the neighbor timeout
+   */
+  void
+  checkNeighbors();
+
+  /**
+   * @brief Check whether @p sta is associated with this AP
+   */
+  bool
+  isAssociated(const Mac48Address& sta) const;
+
+  void
+  onStaAssoc(Mac48Address bssid);
+
+  void
+  onStaDeAssoc(Mac48Address bssid);
+
   Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
   Ptr<Node> m_node;
+  bool m_inMemoryPackets; ///< \brief whether to send NFD packets by reference
+
+  bool m_unicast;                             ///< \brief whether to address the next hop directly
+  Ptr<StaWifiMac> m_staMac;                   ///< \brief set if the device is a wifi STA
+  bool m_isStaAssociated;                     ///< \brief whether the STA is associated
+  Ptr<WifiRemoteStationManager> m_apStations; ///< \brief set if the device is a wifi AP
+  std::vector<Mac48Address> m_associated;     ///< \brief STAs reported through SetAssociated
+
+  Address m_remoteAddress; ///< \brief destination of a per-neighbor transport, invalid otherwise
+
+  struct NeighborFace
+  {
+    std::weak_ptr<Face> face;
+    Time lastHeard;
+  };
+
+  NeighborFaceCreateCallback m_createNeighborFace;
+  Time m_neighborTimeout;
+  std::map<Mac48Address, NeighborFace> m_neighborFaces;
+  EventId m_neighborCheckEvent;
 };
 
 } // namespace ndn
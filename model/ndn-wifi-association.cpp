@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-wifi-association.hpp"
+
+#include "ndn-l3-protocol.hpp"
+#include "ndn-net-device-transport.hpp"
+
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/sta-wifi-mac.h"
+#include "ns3/ap-wifi-mac.h"
+
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.WifiAssociation");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(WifiAssociation);
+
+TypeId
+WifiAssociation::GetTypeId()
+{
+  static TypeId tid = TypeId("ns3::ndn::WifiAssociation")
+    .SetGroupName("Ndn")
+    .SetParent<Object>()
+    .AddConstructor<WifiAssociation>();
+  return tid;
+}
+
+WifiAssociation::WifiAssociation()
+  : m_isAssociated(false)
+{
+}
+
+void
+WifiAssociation::SetDevice(Ptr<WifiNetDevice> device,
+                           const std::vector<FibHelper::Route>& uplinkRoutes)
+{
+  Ptr<StaWifiMac> staMac = DynamicCast<StaWifiMac>(device->GetMac());
+  NS_ASSERT_MSG(staMac != nullptr, "WifiAssociation needs a wifi STA device");
+
+  m_device = device;
+  m_uplinkRoutes = uplinkRoutes;
+
+  m_bssid = staMac->GetBssid();
+  std::ostringstream os;
+  os << Address(m_bssid);
+  m_bssidString = os.str();
+
+  staMac->TraceConnectWithoutContext("Assoc", MakeCallback(&WifiAssociation::onAssoc, this));
+  staMac->TraceConnectWithoutContext("DeAssoc", MakeCallback(&WifiAssociation::onDeAssoc, this));
+}
+
+void
+WifiAssociation::DoDispose()
+{
+  m_uplinkRoutes.clear();
+  m_device = nullptr;
+
+  Object::DoDispose();
+}
+
+void
+WifiAssociation::onAssoc(Mac48Address bssid)
+{
+  NS_LOG_FUNCTION(this << bssid);
+
+  if (m_isAssociated) {
+    if (bssid == m_bssid) {
+      return;
+    }
+    // moved to another AP without a disassociation
+    leave();
+  }
+
+  m_isAssociated = true;
+  if (bssid != m_bssid) {
+    m_bssid = bssid;
+    std::ostringstream os;
+    os << Address(m_bssid);
+    m_bssidString = os.str();
+  }
+
+  FibHelper::AddRoutesDirect(m_device->GetNode(), m_uplinkRoutes);
+  notifyAp(m_bssid, true);
+}
+
+void
+WifiAssociation::onDeAssoc(Mac48Address bssid)
+{
+  NS_LOG_FUNCTION(this << bssid);
+
+  if (m_isAssociated) {
+    leave();
+  }
+}
+
+void
+WifiAssociation::leave()
+{
+  m_isAssociated = false;
+  FibHelper::RemoveRoutesDirect(m_device->GetNode(), m_uplinkRoutes);
+  notifyAp(m_bssid, false);
+}
+
+Ptr<WifiNetDevice>
+WifiAssociation::FindAp(const Mac48Address& bssid)
+{
+  for (auto node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if ((*node)->GetObject<L3Protocol>() == nullptr) {
+      continue;
+    }
+
+    for (uint32_t i = 0; i < (*node)->GetNDevices(); i++) {
+      Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>((*node)->GetDevice(i));
+      if (device != nullptr && DynamicCast<ApWifiMac>(device->GetMac()) != nullptr &&
+          Mac48Address::ConvertFrom(device->GetAddress()) == bssid) {
+        return device;
+      }
+    }
+  }
+  return nullptr;
+}
+
+void
+WifiAssociation::notifyAp(const Mac48Address& bssid, bool isAssociated) const
+{
+  Mac48Address sta = Mac48Address::ConvertFrom(m_device->GetAddress());
+
+  // handoffs are rare, so the AP is looked up only when one happens
+  Ptr<WifiNetDevice> ap = FindAp(bssid);
+  if (ap == nullptr) {
+    return;
+  }
+
+  shared_ptr<Face> face = ap->GetNode()->GetObject<L3Protocol>()->getFaceByNetDevice(ap);
+  if (face == nullptr) {
+    return;
+  }
+  auto transport = dynamic_cast<NetDeviceTransport*>(face->getTransport());
+  if (transport != nullptr) {
+    transport->SetAssociated(sta, isAssociated);
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_MODEL_NDN_WIFI_ASSOCIATION_HPP
+#define NDNSIM_MODEL_NDN_WIFI_ASSOCIATION_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/helper/ndn-fib-helper.hpp"
+
+#include "ns3/object.h"
+#include "ns3/mac48-address.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+class WifiNetDevice;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Association state of a wifi STA, kept up to date from the association traces
+ *
+ * Installed by MobilityRoutingHelper and aggregated to the STA node, so it can be obtained
+ * with `node->GetObject<WifiAssociation>()`.  When the STA associates, the uplink routes are
+ * added to the FIB of the node on the face of the STA device and the serving AP is told about
+ * the STA (see NetDeviceTransport::SetAssociated).  When it disassociates or moves to another
+ * AP, both are undone.
+ *
+ * There is deliberately no fallback route while the STA is not associated: the MAC would drop
+ * anything sent in the meantime, so Interests for the uplink prefixes are rejected by the
+ * forwarder (NoRoute Nack) instead, and consumers retransmit them when they time out.
+ */
+class WifiAssociation : public Object {
+public:
+  static TypeId
+  GetTypeId();
+
+  WifiAssociation();
+
+  /**
+   * @brief Find the AP device with @p bssid on a node with NDN stack installed
+   *
+   * Goes through all nodes of the simulation, so it is meant for rare events such as handoffs.
+   *
+   * @returns nullptr if there is no such AP
+   */
+  static Ptr<WifiNetDevice>
+  FindAp(const Mac48Address& bssid);
+
+  /**
+   * @brief Follow association of the STA @p device, keeping @p uplinkRoutes while associated
+   */
+  void
+  SetDevice(Ptr<WifiNetDevice> device, const std::vector<FibHelper::Route>& uplinkRoutes);
+
+  bool
+  IsAssociated() const
+  {
+    return m_isAssociated;
+  }
+
+  /**
+   * @brief Get BSSID of the current AP, or of the last one if the STA is not associated
+   */
+  const Mac48Address&
+  GetBssid() const
+  {
+    return m_bssid;
+  }
+
+  /**
+   * @brief Get GetBssid() formatted as ns3::Address, as used in prefetch Interest names
+   */
+  const std::string&
+  GetBssidString() const
+  {
+    return m_bssidString;
+  }
+
+protected:
+  virtual void
+  DoDispose() override;
+
+private:
+  void
+  onAssoc(Mac48Address bssid);
+
+  void
+  onDeAssoc(Mac48Address bssid);
+
+  /**
+   * @brief Undo the effects of the current association
+   */
+  void
+  leave();
+
+  /**
+   * @brief Tell the AP with @p bssid whether this STA is associated with it
+   */
+  void
+  notifyAp(const Mac48Address& bssid, bool isAssociated) const;
+
+private:
+  Ptr<WifiNetDevice> m_device;
+  std::vector<FibHelper::Route> m_uplinkRoutes; ///< @brief routes towards the serving AP
+  bool m_isAssociated;
+  Mac48Address m_bssid;
+  std::string m_bssidString; ///< @brief m_bssid formatted once per association
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_MODEL_NDN_WIFI_ASSOCIATION_HPP
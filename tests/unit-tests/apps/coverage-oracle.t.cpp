@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/precache-strategy/coverage-oracle.hpp"
+
+#include "ns3/node-container.h"
+#include "ns3/mobility-module.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(AppsCoverageOracle, CleanupFixture)
+
+static const int64_t S = 1000000000;
+
+BOOST_AUTO_TEST_CASE(Corridor)
+{
+  // same layout as examples/basic.cpp: APs every 200m starting at 100m, 60m range, 20m/s
+  NodeContainer aps;
+  aps.Create(6);
+  NodeContainer vehicles;
+  vehicles.Create(1);
+
+  MobilityHelper sessile;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+  for (int i = 0; i < 6; i++) {
+    positionAlloc->Add(Vector(100 + 200 * i, 0.0, 0.0));
+  }
+  sessile.SetPositionAllocator(positionAlloc);
+  sessile.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+  sessile.Install(aps);
+
+  MobilityHelper mobile;
+  mobile.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+  mobile.Install(vehicles);
+  Ptr<ConstantVelocityMobilityModel> cvmm = vehicles.Get(0)->GetObject<ConstantVelocityMobilityModel>();
+  cvmm->SetPosition(Vector(0, 0, 0));
+  cvmm->SetVelocity(Vector(20, 0, 0));
+
+  CoverageOracle::Install(aps, 60, vehicles);
+
+  Ptr<CoverageOracle> oracle = vehicles.Get(0)->GetObject<CoverageOracle>();
+  BOOST_REQUIRE(oracle != nullptr);
+  BOOST_REQUIRE_EQUAL(oracle->GetNEntries(), 6);
+  BOOST_REQUIRE_EQUAL(oracle->GetNHandoffs(), 6);
+
+  for (int i = 0; i < 6; i++) {
+    BOOST_CHECK_LE(std::abs(oracle->GetEntry(i) - (2 + 10 * i) * S), 1000);
+    BOOST_CHECK_LE(std::abs(oracle->GetHandoff(i) - (8 + 10 * i) * S), 1000);
+  }
+
+  BOOST_CHECK_EQUAL(oracle->HasCoverage(1 * S), false);
+  BOOST_CHECK_EQUAL(oracle->HasCoverage(5 * S), true);
+  BOOST_CHECK_EQUAL(oracle->HasCoverage(10 * S), false);
+  BOOST_CHECK_EQUAL(oracle->HasCoverage(15 * S), true);
+  BOOST_CHECK_EQUAL(oracle->HasCoverage(60 * S), false);
+
+  BOOST_CHECK_EQUAL(oracle->GetNextEntryIndex(10 * S), 1);
+  BOOST_CHECK_EQUAL(oracle->GetNextHandoffIndex(10 * S), 1);
+  BOOST_CHECK_EQUAL(oracle->GetNHandoffsBefore(20 * S), 2);
+  BOOST_CHECK_LE(std::abs(oracle->GetTimeToNextEntry(10 * S) - 2 * S), 1000);
+  BOOST_CHECK_LE(std::abs(oracle->GetTimeToNextHandoff(10 * S) - 8 * S), 1000);
+  BOOST_CHECK_EQUAL(oracle->GetTimeToNextEntry(60 * S), -1);
+  BOOST_CHECK_EQUAL(oracle->GetTimeToNextHandoff(60 * S), -1);
+}
+
+BOOST_AUTO_TEST_CASE(OverlappingCoverage)
+{
+  Ptr<CoverageOracle> oracle = CreateObject<CoverageOracle>();
+  oracle->AddCoverage(10 * S, 30 * S);
+  oracle->AddCoverage(0 * S, 12 * S);
+  oracle->AddCoverage(40 * S, 50 * S);
+  oracle->Finalize();
+
+  BOOST_CHECK_EQUAL(oracle->GetEntry(0), 0);
+  BOOST_CHECK_EQUAL(oracle->GetEntry(1), 10 * S);
+  BOOST_CHECK_EQUAL(oracle->HasCoverage(11 * S), true);
+  BOOST_CHECK_EQUAL(oracle->HasCoverage(20 * S), true);
+  BOOST_CHECK_EQUAL(oracle->HasCoverage(35 * S), false);
+  BOOST_CHECK_EQUAL(oracle->HasCoverage(45 * S), true);
+  BOOST_CHECK_EQUAL(oracle->HasCoverage(50 * S), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
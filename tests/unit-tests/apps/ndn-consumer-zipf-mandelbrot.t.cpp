@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-consumer-zipf-mandelbrot.hpp"
+
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include <cmath>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(AppsConsumerZipfMandelbrot, CleanupFixture)
+
+static std::vector<double>
+expectedProbabilities(uint32_t n, double q, double s)
+{
+  std::vector<double> p(n + 1, 0.0);
+  double total = 0.0;
+  for (uint32_t i = 1; i <= n; i++) {
+    p[i] = 1.0 / std::pow(i + q, s);
+    total += p[i];
+  }
+  for (auto& value : p) {
+    value /= total;
+  }
+  return p;
+}
+
+static void
+checkDistribution(const std::string& sampler, uint32_t n)
+{
+  Ptr<ConsumerZipfMandelbrot> consumer = CreateObject<ConsumerZipfMandelbrot>();
+  consumer->SetAttribute("NumberOfContents", UintegerValue(n));
+  consumer->SetAttribute("Sampler", StringValue(sampler));
+
+  const int nDraws = 200000;
+  std::vector<int> counts(n + 1, 0);
+  for (int i = 0; i < nDraws; i++) {
+    uint32_t seq = consumer->GetNextSeq();
+    BOOST_REQUIRE_GE(seq, 1);
+    BOOST_REQUIRE_LE(seq, n);
+    counts[seq]++;
+  }
+
+  std::vector<double> expected = expectedProbabilities(n, 0.7, 0.7);
+  for (uint32_t i = 1; i <= std::min<uint32_t>(n, 20); i++) {
+    BOOST_CHECK_SMALL(static_cast<double>(counts[i]) / nDraws - expected[i], 0.005);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Cumulative)
+{
+  checkDistribution("cumulative", 100);
+}
+
+BOOST_AUTO_TEST_CASE(Alias)
+{
+  checkDistribution("alias", 100);
+}
+
+BOOST_AUTO_TEST_CASE(SamplerAttribute)
+{
+  Ptr<ConsumerZipfMandelbrot> consumer = CreateObject<ConsumerZipfMandelbrot>();
+  StringValue sampler;
+  consumer->GetAttribute("Sampler", sampler);
+  BOOST_CHECK_EQUAL(sampler.Get(), "cumulative");
+
+  consumer->SetAttribute("Sampler", StringValue("alias"));
+  consumer->GetAttribute("Sampler", sampler);
+  BOOST_CHECK_EQUAL(sampler.Get(), "alias");
+}
+
+BOOST_AUTO_TEST_CASE(LargeCatalogue)
+{
+  // large enough to build the tables on several threads
+  checkDistribution("cumulative", 200000);
+  checkDistribution("alias", 200000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-consumer.hpp"
+
+#include <map>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(AppsConsumer, ScenarioHelperWithCleanupFixture)
+
+struct SentInterest
+{
+  shared_ptr<const Interest> interest;
+  Name name;
+  uint32_t nonce;
+};
+
+static void
+recordInterest(std::vector<SentInterest>* sent, shared_ptr<const Interest> interest, Ptr<App>,
+               shared_ptr<Face>)
+{
+  sent->push_back(SentInterest{interest, interest->getName(), interest->getNonce()});
+}
+
+BOOST_AUTO_TEST_CASE(InterestEncoding)
+{
+  createTopology({
+      {"1", "2"},
+    });
+
+  // nobody answers, so the first Interest is retransmitted while the PIT still holds it
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "1"}, {"LifeTime", "3s"}},
+          "0s", "5s"},
+    });
+
+  std::vector<SentInterest> sent;
+  getNode("1")->GetApplication(0)->TraceConnectWithoutContext("TransmittedInterests",
+                                                              MakeBoundCallback(&recordInterest,
+                                                                                &sent));
+
+  Simulator::Stop(Seconds(5.001));
+  Simulator::Run();
+
+  BOOST_REQUIRE_GE(sent.size(), 2);
+
+  std::map<Name, std::vector<const SentInterest*>> transmissions;
+  for (const SentInterest& item : sent) {
+    const Name& name = item.name;
+    BOOST_REQUIRE_EQUAL(name.size(), 3);
+    BOOST_CHECK_EQUAL(name.getPrefix(1), Name("/prefix"));
+
+    uint64_t seq = name.get(-1).toSequenceNumber();
+    BOOST_CHECK_EQUAL(name, Name("/prefix").append(std::to_string(seq)).appendSequenceNumber(seq));
+    BOOST_CHECK_EQUAL(item.interest->getInterestLifetime(), time::seconds(3));
+
+    transmissions[name].push_back(&item);
+  }
+  BOOST_CHECK_EQUAL(sent[0].name, Name("/prefix").append("0").appendSequenceNumber(0));
+
+  bool hasRetransmissions = false;
+  for (const auto& item : transmissions) {
+    hasRetransmissions = hasRetransmissions || item.second.size() > 1;
+    for (size_t i = 1; i < item.second.size(); i++) {
+      // every retransmission gets its own nonce
+      BOOST_CHECK_NE(item.second[i]->nonce, item.second[i - 1]->nonce);
+      BOOST_CHECK(item.second[i]->interest != item.second[i - 1]->interest);
+    }
+  }
+  BOOST_CHECK(hasRetransmissions);
+
+  // Interests that have been sent are never patched afterwards
+  for (const SentInterest& item : sent) {
+    BOOST_CHECK_EQUAL(item.interest->getName(), item.name);
+    BOOST_CHECK_EQUAL(item.interest->getNonce(), item.nonce);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-producer.hpp"
+
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(AppsProducer, ScenarioHelperWithCleanupFixture)
+
+struct SentData
+{
+  shared_ptr<const Data> data;
+  Time time;
+};
+
+static void
+recordData(std::vector<SentData>* sent, shared_ptr<const Data> data, Ptr<App>, shared_ptr<Face>)
+{
+  sent->push_back(SentData{data, Simulator::Now()});
+}
+
+static void
+countData(size_t* nData, shared_ptr<const Data>, Ptr<App>, shared_ptr<Face>)
+{
+  (*nData)++;
+}
+
+/**
+ * @brief Encode Data the way Producer did before it used a pre-encoded template
+ */
+static Block
+makeReferenceData(const Name& name, uint32_t payloadSize, Time freshness, uint32_t signatureValue,
+                  const Name& keyLocator)
+{
+  auto data = make_shared<Data>();
+  data->setName(name);
+  data->setFreshnessPeriod(::ndn::time::milliseconds(freshness.GetMilliSeconds()));
+  data->setContent(make_shared< ::ndn::Buffer>(payloadSize));
+
+  Signature signature;
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+  if (keyLocator.size() > 0) {
+    signatureInfo.setKeyLocator(keyLocator);
+  }
+  signature.setInfo(signatureInfo);
+  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue,
+                                                        signatureValue));
+  data->setSignature(signature);
+
+  return data->wireEncode();
+}
+
+static void
+checkData(const Data& data, uint32_t payloadSize, Time freshness, uint32_t signatureValue,
+          const Name& keyLocator)
+{
+  BOOST_CHECK_EQUAL(data.getName().getPrefix(1), Name("/prefix"));
+  BOOST_CHECK_EQUAL(data.getContent().value_size(), payloadSize);
+  BOOST_CHECK(data.getFreshnessPeriod() == ::ndn::time::milliseconds(freshness.GetMilliSeconds()));
+  BOOST_CHECK_EQUAL(data.getSignature().getType(), 255);
+  BOOST_REQUIRE(data.getSignature().hasKeyLocator());
+  BOOST_CHECK_EQUAL(data.getSignature().getKeyLocator().getName(), keyLocator);
+  BOOST_CHECK_EQUAL(::ndn::readNonNegativeInteger(data.getSignature().getValue()), signatureValue);
+
+  // byte for byte the same as the Data the producer used to build for every Interest
+  Block reference = makeReferenceData(data.getName(), payloadSize, freshness, signatureValue,
+                                      keyLocator);
+  const Block& wire = data.wireEncode();
+  BOOST_CHECK_EQUAL_COLLECTIONS(wire.begin(), wire.end(), reference.begin(), reference.end());
+}
+
+BOOST_AUTO_TEST_CASE(DataTemplate)
+{
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "4s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "100"}, {"Freshness", "2s"},
+           {"Signature", "7"}, {"KeyLocator", "/key"}},
+          "0s", "100s"}
+    });
+
+  Ptr<Application> producer = getNode("2")->GetApplication(0);
+  std::vector<SentData> sent;
+  producer->TraceConnectWithoutContext("TransmittedDatas", MakeBoundCallback(&recordData, &sent));
+  size_t nReceived = 0;
+  getNode("1")->GetApplication(0)->TraceConnectWithoutContext("ReceivedDatas",
+                                                              MakeBoundCallback(&countData,
+                                                                                &nReceived));
+
+  // attributes changed while the producer is running apply to the following Data
+  nfd::scheduler::schedule(time::milliseconds(2500), [producer] {
+      producer->SetAttribute("PayloadSize", UintegerValue(300));
+      producer->SetAttribute("Freshness", TimeValue(Seconds(1)));
+      producer->SetAttribute("Signature", UintegerValue(8));
+      producer->SetAttribute("KeyLocator", StringValue("/other-key"));
+    });
+
+  Simulator::Stop(Seconds(5));
+  Simulator::Run();
+
+  size_t nBefore = 0;
+  size_t nAfter = 0;
+  for (const SentData& item : sent) {
+    if (item.time < Seconds(2.5)) {
+      checkData(*item.data, 100, Seconds(2), 7, "/key");
+      nBefore++;
+    }
+    else {
+      checkData(*item.data, 300, Seconds(1), 8, "/other-key");
+      nAfter++;
+    }
+  }
+  BOOST_CHECK_GT(nBefore, 10);
+  BOOST_CHECK_GT(nAfter, 10);
+  BOOST_CHECK_EQUAL(nReceived, sent.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
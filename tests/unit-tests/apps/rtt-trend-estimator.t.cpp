@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/precache-strategy/rtt-trend-estimator.hpp"
+
+#include <tuple>
+#include <vector>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(AppsRttTrendEstimator)
+
+// ordinary least squares over (1, y[0]), ..., (n, y[n-1])
+static std::pair<double, double>
+fitLine(const std::vector<int64_t>& y)
+{
+  double n = y.size();
+  double sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+  for (size_t i = 0; i < y.size(); i++) {
+    double x = i + 1;
+    sumX += x;
+    sumY += y[i];
+    sumXX += x * x;
+    sumXY += x * y[i];
+  }
+  double slope = (n * sumXY - sumX * sumY) / (n * sumXX - sumX * sumX);
+  return std::make_pair(slope, (sumY - slope * sumX) / n);
+}
+
+// intercept at x = 0, from the mean and slope reported by the estimator
+static double
+getIntercept(const RttTrendEstimator& estimator)
+{
+  return estimator.GetMean() - estimator.GetSlope() * (estimator.GetSize() + 1) / 2.0;
+}
+
+BOOST_AUTO_TEST_CASE(ClosedFormFit)
+{
+  std::vector<int64_t> samples = {12000000, 15000000, 11000000, 20000000, 26000000};
+  RttTrendEstimator estimator(5);
+  int64_t tp = 0;
+  for (int64_t sample : samples) {
+    estimator.AddSample(sample, tp += 100000000);
+  }
+
+  double slope, intercept;
+  std::tie(slope, intercept) = fitLine(samples);
+  BOOST_CHECK_EQUAL(estimator.GetSize(), 5);
+  BOOST_CHECK_CLOSE(estimator.GetSlope(), slope, 1e-9);
+  BOOST_CHECK_CLOSE(getIntercept(estimator), intercept, 1e-9);
+  BOOST_CHECK_CLOSE(estimator.GetMean(), 16800000, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(SlidingWindow)
+{
+  std::vector<int64_t> samples = {50, 40, 70, 10, 90, 30, 60, 80, 20, 100, 5, 45};
+  RttTrendEstimator estimator(4);
+
+  for (size_t i = 0; i < samples.size(); i++) {
+    estimator.AddSample(samples[i], i * 100000000);
+
+    size_t first = i + 1 > 4 ? i + 1 - 4 : 0;
+    std::vector<int64_t> window(samples.begin() + first, samples.begin() + i + 1);
+    BOOST_CHECK_EQUAL(estimator.GetSize(), window.size());
+    if (window.size() < 2)
+      continue;
+
+    double slope, intercept;
+    std::tie(slope, intercept) = fitLine(window);
+    BOOST_CHECK_SMALL(estimator.GetSlope() - slope, 1e-9);
+    BOOST_CHECK_SMALL(getIntercept(estimator) - intercept, 1e-9);
+  }
+
+  // changing the window drops all samples
+  estimator.SetWindowSize(3);
+  BOOST_CHECK_EQUAL(estimator.GetWindowSize(), 3);
+  BOOST_CHECK_EQUAL(estimator.GetSize(), 0);
+  BOOST_CHECK_EQUAL(estimator.GetSlope(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(TimeToThreshold)
+{
+  // RTT grows by 2 ms per sample, one sample every 100 ms
+  RttTrendEstimator estimator(5);
+  for (int64_t i = 0; i < 8; i++) {
+    estimator.AddSample(10000000 + i * 2000000, i * 100000000);
+  }
+  BOOST_CHECK_CLOSE(estimator.GetSlope(), 2000000, 1e-9);
+
+  // the newest sample is 24 ms: 30 ms is 3 samples away, 29 ms is crossed by the third one
+  BOOST_CHECK_EQUAL(estimator.GetPredictedTimeToThreshold(30000000), 300000000);
+  BOOST_CHECK_EQUAL(estimator.GetPredictedTimeToThreshold(29000000), 300000000);
+  BOOST_CHECK_EQUAL(estimator.GetPredictedTimeToThreshold(24000000), 0);
+  BOOST_CHECK_EQUAL(estimator.GetPredictedTimeToThreshold(20000000), 0);
+
+  // samples twice as far apart take twice as long to get there
+  RttTrendEstimator slower(5);
+  for (int64_t i = 0; i < 5; i++) {
+    slower.AddSample(10000000 + i * 2000000, i * 200000000);
+  }
+  BOOST_CHECK_EQUAL(slower.GetPredictedTimeToThreshold(30000000), 1200000000);
+
+  // a shrinking RTT never reaches a higher threshold
+  RttTrendEstimator shrinking(5);
+  for (int64_t i = 0; i < 5; i++) {
+    shrinking.AddSample(30000000 - i * 2000000, i * 100000000);
+  }
+  BOOST_CHECK_EQUAL(shrinking.GetPredictedTimeToThreshold(40000000), RttTrendEstimator::NEVER);
+  BOOST_CHECK_EQUAL(shrinking.GetPredictedTimeToThreshold(20000000), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Degenerate)
+{
+  RttTrendEstimator estimator(5);
+  BOOST_CHECK_EQUAL(estimator.GetMean(), 0);
+  BOOST_CHECK_EQUAL(estimator.GetSlope(), 0);
+
+  // a single sample does not define a line
+  estimator.AddSample(7000000, 0);
+  BOOST_CHECK_EQUAL(estimator.GetMean(), 7000000);
+  BOOST_CHECK_EQUAL(estimator.GetSlope(), 0);
+  BOOST_CHECK_EQUAL(estimator.GetPredictedTimeToThreshold(8000000), RttTrendEstimator::NEVER);
+
+  // x is the position in the window and never repeats, identical y gives a flat line
+  for (int i = 1; i <= 10; i++) {
+    estimator.AddSample(7000000, i * 100000000);
+  }
+  BOOST_CHECK_EQUAL(estimator.GetSlope(), 0);
+  BOOST_CHECK_EQUAL(getIntercept(estimator), 7000000);
+  BOOST_CHECK_EQUAL(estimator.GetPredictedTimeToThreshold(8000000), RttTrendEstimator::NEVER);
+
+  // window of one sample never has two points
+  RttTrendEstimator single(1);
+  single.AddSample(1, 0);
+  single.AddSample(100, 100000000);
+  BOOST_CHECK_EQUAL(single.GetSize(), 1);
+  BOOST_CHECK_EQUAL(single.GetMean(), 100);
+  BOOST_CHECK_EQUAL(single.GetSlope(), 0);
+
+  // zero window is treated as one
+  RttTrendEstimator zero(0);
+  BOOST_CHECK_EQUAL(zero.GetWindowSize(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
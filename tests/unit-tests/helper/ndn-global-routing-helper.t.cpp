@@ -147,6 +147,66 @@ BOOST_AUTO_TEST_CASE(CalculateRouteCase2)
   }
 }
 
+BOOST_AUTO_TEST_CASE(CalculateAllPossibleRoutes)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A3  NA  1 1 1\n"
+        << "B3  NA  80  -40 1\n"
+        << "C3  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A3      B3  10Mbps    100 1ms 100\n"
+        << "A3      C3  10Mbps    50  1ms 100\n"
+        << "B3      C3  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C3"));
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+
+  // A3 reaches C3 directly and through B3; B3 reaches C3 directly and through A3
+  std::map<std::string, std::map<std::string, uint64_t>> costs;
+  for (const auto& nodeName : {"A3", "B3"}) {
+    auto ndn = Names::Find<Node>(nodeName)->GetObject<ndn::L3Protocol>();
+    const nfd::fib::Entry* entry = ndn->getForwarder()->getFib().findExactMatch("/prefix");
+    BOOST_REQUIRE(entry != nullptr);
+    for (const auto& nextHop : entry->getNextHops()) {
+      auto transport = dynamic_cast<NetDeviceTransport*>(nextHop.getFace().getTransport());
+      BOOST_REQUIRE(transport != nullptr);
+      Ptr<Channel> channel = transport->GetNetDevice()->GetChannel();
+      Ptr<Node> other = channel->GetDevice(0) == transport->GetNetDevice() ?
+                          channel->GetDevice(1)->GetNode() : channel->GetDevice(0)->GetNode();
+      costs[nodeName][Names::FindName(other)] = nextHop.getCost();
+    }
+  }
+
+  BOOST_CHECK_EQUAL(costs["A3"].size(), 2);
+  BOOST_CHECK_EQUAL(costs["A3"]["C3"], 50);
+  BOOST_CHECK_EQUAL(costs["A3"]["B3"], 101);
+  BOOST_CHECK_EQUAL(costs["B3"].size(), 2);
+  BOOST_CHECK_EQUAL(costs["B3"]["C3"], 1);
+  BOOST_CHECK_EQUAL(costs["B3"]["A3"], 150);
+
+  // face metrics are left untouched
+  auto ndn = Names::Find<Node>("A3")->GetObject<ndn::L3Protocol>();
+  for (const auto& face : ndn->getForwarder()->getFaceTable()) {
+    BOOST_CHECK_NE(face.getMetric(), std::numeric_limits<uint16_t>::max() - 1);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -18,6 +18,8 @@
  **/
 
 #include "helper/ndn-link-control-helper.hpp"
+#include "helper/ndn-global-routing-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
 #include "NFD/core/scheduler.hpp"
 
 #include "../tests-common.hpp"
@@ -148,6 +150,45 @@ BOOST_AUTO_TEST_CASE(SixNodeTopology) // Bug #2783
   Simulator::Run();
 }
 
+BOOST_AUTO_TEST_CASE(IncrementalGlobalRouting)
+{
+  createTopology({
+      {"1", "2"},
+      {"2", "3"},
+      {"1", "3"},
+    });
+
+  GlobalRoutingHelper::SetIncrementalRouting(true);
+
+  GlobalRoutingHelper routingHelper;
+  routingHelper.InstallAll();
+  routingHelper.AddOrigin("/prefix", getNode("3"));
+  GlobalRoutingHelper::CalculateRoutes();
+
+  typedef std::map<nfd::FaceId, uint64_t> NextHops;
+  auto getNextHops = [this] {
+    NextHops nextHops;
+    auto ndn = getNode("1")->GetObject<L3Protocol>();
+    const nfd::fib::Entry* entry = ndn->getForwarder()->getFib().findExactMatch("/prefix");
+    if (entry != nullptr) {
+      for (const auto& nextHop : entry->getNextHops()) {
+        nextHops[nextHop.getFace().getId()] = nextHop.getCost();
+      }
+    }
+    return nextHops;
+  };
+
+  BOOST_CHECK(getNextHops() == (NextHops{{getFace("1", "3")->getId(), 1}}));
+
+  LinkControlHelper::FailLink(getNode("1"), getNode("3"));
+  BOOST_CHECK(getNextHops() == (NextHops{{getFace("1", "2")->getId(), 2}}));
+
+  LinkControlHelper::UpLink(getNode("1"), getNode("3"));
+  BOOST_CHECK(getNextHops() == (NextHops{{getFace("1", "3")->getId(), 1}}));
+
+  GlobalRoutingHelper::SetIncrementalRouting(false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-mobility-routing-helper.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "NFD/core/scheduler.hpp"
+
+#include "../tests-common.hpp"
+
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(HelperMobilityRoutingHelper, CleanupFixture)
+
+static bool
+hasUplinkRoute(Ptr<Node> node, const Name& prefix)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  shared_ptr<Face> face = ndn->getFaceByNetDevice(node->GetDevice(0));
+  const nfd::fib::Entry* entry = ndn->getForwarder()->getFib().findExactMatch(prefix);
+  return entry != nullptr && entry->hasNextHop(*face);
+}
+
+BOOST_AUTO_TEST_CASE(FollowAssociation)
+{
+  NodeContainer ap;
+  ap.Create(1);
+  NodeContainer sta;
+  sta.Create(1);
+
+  WifiHelper wifi;
+  wifi.SetStandard(WIFI_PHY_STANDARD_80211a);
+  YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default();
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default();
+  wifiChannel.AddPropagationLoss("ns3::RangePropagationLossModel",
+                                 "MaxRange", DoubleValue(50.0));
+  wifiPhy.SetChannel(wifiChannel.Create());
+
+  NqosWifiMacHelper wifiMac = NqosWifiMacHelper::Default();
+  Ssid ssid("mobility");
+  wifiMac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+  NetDeviceContainer apDevice = wifi.Install(wifiPhy, wifiMac, ap);
+  wifiMac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
+  wifi.Install(wifiPhy, wifiMac, sta);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+  mobility.Install(ap);
+  mobility.Install(sta);
+  sta.Get(0)->GetObject<MobilityModel>()->SetPosition(Vector(10.0, 0.0, 0.0));
+
+  StackHelper ndnHelper;
+  ndnHelper.Install(ap);
+  ndnHelper.Install(sta);
+
+  MobilityRoutingHelper mobilityRouting;
+  mobilityRouting.AddUplinkPrefix("/prefix", 1);
+  mobilityRouting.Install(sta);
+
+  Ptr<WifiAssociation> association = sta.Get(0)->GetObject<WifiAssociation>();
+  BOOST_REQUIRE(association != nullptr);
+  BOOST_CHECK(!association->IsAssociated());
+  BOOST_CHECK(!hasUplinkRoute(sta.Get(0), "/prefix"));
+
+  nfd::scheduler::schedule(time::milliseconds(1000), [&] {
+      BOOST_CHECK(association->IsAssociated());
+      BOOST_CHECK_EQUAL(association->GetBssid(),
+                        Mac48Address::ConvertFrom(apDevice.Get(0)->GetAddress()));
+      BOOST_CHECK(hasUplinkRoute(sta.Get(0), "/prefix"));
+
+      // out of range of the AP, which will be noticed after missing its beacons
+      sta.Get(0)->GetObject<MobilityModel>()->SetPosition(Vector(1000.0, 0.0, 0.0));
+    });
+
+  nfd::scheduler::schedule(time::milliseconds(4000), [&] {
+      BOOST_CHECK(!association->IsAssociated());
+      BOOST_CHECK(!hasUplinkRoute(sta.Get(0), "/prefix"));
+    });
+
+  Simulator::Stop(Seconds(4.1));
+  Simulator::Run();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
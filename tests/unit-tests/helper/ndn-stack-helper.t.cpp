@@ -18,9 +18,13 @@
  **/
 
 #include "helper/ndn-stack-helper.hpp"
+#include "NFD/core/scheduler.hpp"
 #include "../tests-common.hpp"
 
 #include "ns3/point-to-point-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/ndnSIM/helper/ndn-app-helper.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -62,6 +66,74 @@ BOOST_AUTO_TEST_CASE(TestNfdContentStorePolicy)
   BOOST_CHECK_EQUAL(protoNode1->getForwarder()->getCs().getPolicy()->getName(), "priority_fifo");
 }
 
+static size_t
+countNeighborFaces(Ptr<Node> node)
+{
+  size_t nFaces = 0;
+  for (const auto& face : L3Protocol::getL3Protocol(node)->getForwarder()->getFaceTable()) {
+    if (face.getPersistency() == ::ndn::nfd::FACE_PERSISTENCY_ON_DEMAND &&
+        face.getLocalUri().getScheme() == "netdev") {
+      nFaces++;
+    }
+  }
+  return nFaces;
+}
+
+BOOST_AUTO_TEST_CASE(WifiNeighborFaces)
+{
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  WifiHelper wifi;
+  wifi.SetStandard(WIFI_PHY_STANDARD_80211a);
+  YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default();
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default();
+  wifiPhy.SetChannel(wifiChannel.Create());
+  NqosWifiMacHelper wifiMac = NqosWifiMacHelper::Default();
+  wifiMac.SetType("ns3::AdhocWifiMac");
+  wifi.Install(wifiPhy, wifiMac, nodes);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+  positionAlloc->Add(Vector(0.0, 0.0, 0.0));
+  positionAlloc->Add(Vector(10.0, 0.0, 0.0));
+  positionAlloc->Add(Vector(20.0, 0.0, 0.0));
+  mobility.SetPositionAllocator(positionAlloc);
+  mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+  mobility.Install(nodes);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetWifiNeighborFaces(true, Seconds(1));
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.Install(nodes);
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", StringValue("10"));
+  consumerHelper.Install(nodes.Get(0)).Stop(Seconds(2));
+
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.Install(nodes.Get(1));
+
+  // nodes 0 and 1 hear each other, node 2 overhears both
+  nfd::scheduler::schedule(time::milliseconds(1900), [&] {
+      BOOST_CHECK_EQUAL(countNeighborFaces(nodes.Get(0)), 1);
+      BOOST_CHECK_EQUAL(countNeighborFaces(nodes.Get(1)), 1);
+      BOOST_CHECK_EQUAL(countNeighborFaces(nodes.Get(2)), 2);
+    });
+
+  // silence for more than the neighbor timeout
+  nfd::scheduler::schedule(time::milliseconds(4000), [&] {
+      BOOST_CHECK_EQUAL(countNeighborFaces(nodes.Get(0)), 0);
+      BOOST_CHECK_EQUAL(countNeighborFaces(nodes.Get(1)), 0);
+      BOOST_CHECK_EQUAL(countNeighborFaces(nodes.Get(2)), 0);
+    });
+
+  Simulator::Stop(Seconds(4.1));
+  Simulator::Run();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -18,6 +18,7 @@
  **/
 
 #include "helper/ndn-strategy-choice-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
 
 #include "ns3/ndnSIM/NFD/daemon/fw/strategy.hpp"
 
@@ -140,6 +141,33 @@ BOOST_AUTO_TEST_CASE(InstallAllBuiltInStrategy)
   BOOST_CHECK_EQUAL(getFace("A2", "C2")->getCounters().nOutInterests, 5);
 }
 
+// static void
+// InstallDirect(const NodeContainer& c, const Name& namePrefix, const Name& strategy);
+BOOST_AUTO_TEST_CASE(InstallDirectBuiltInStrategy)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("A2"));
+
+  Name multicast("/localhost/nfd/strategy/multicast");
+  StrategyChoiceHelper::InstallDirect(nodes, "/prefix", multicast);
+
+  // the entry is in the Strategy Choice table right away, without a management command
+  auto& a1Choice = getNode("A1")->GetObject<L3Protocol>()->getForwarder()->getStrategyChoice();
+  auto& a2Choice = getNode("A2")->GetObject<L3Protocol>()->getForwarder()->getStrategyChoice();
+  BOOST_CHECK(!multicast.isPrefixOf(a1Choice.findEffectiveStrategy("/prefix/1").getInstanceName()));
+  BOOST_CHECK(multicast.isPrefixOf(a2Choice.findEffectiveStrategy("/prefix/1").getInstanceName()));
+  BOOST_CHECK(!multicast.isPrefixOf(a2Choice.findEffectiveStrategy("/other").getInstanceName()));
+
+  Simulator::Stop(Seconds(5.0));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(getFace("A1", "B1")->getCounters().nOutInterests, 0);
+  BOOST_CHECK_EQUAL(getFace("A1", "C1")->getCounters().nOutInterests, 5);
+
+  BOOST_CHECK_EQUAL(getFace("A2", "B2")->getCounters().nOutInterests, 5);
+  BOOST_CHECK_EQUAL(getFace("A2", "C2")->getCounters().nOutInterests, 5);
+}
+
 
 class NullStrategy : public nfd::fw::Strategy {
 public:
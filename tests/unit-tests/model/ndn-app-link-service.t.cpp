@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-app-link-service.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "apps/ndn-app.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-app-helper.hpp"
+#include "NFD/core/scheduler.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnAppLinkService, CleanupFixture)
+
+typedef std::vector<std::pair<Time, std::string>> Deliveries;
+
+static void
+onInterest(Deliveries* deliveries, shared_ptr<const Interest> interest, Ptr<App>,
+           shared_ptr<Face>)
+{
+  deliveries->push_back({Simulator::Now(), "Interest " + interest->getName().toUri()});
+}
+
+static void
+onData(Deliveries* deliveries, shared_ptr<const Data> data, Ptr<App>, shared_ptr<Face>)
+{
+  deliveries->push_back({Simulator::Now(), "Data " + data->getName().toUri()});
+}
+
+static void
+onNack(Deliveries* deliveries, shared_ptr<const lp::Nack> nack, Ptr<App>, shared_ptr<Face>)
+{
+  deliveries->push_back({Simulator::Now(), "Nack " + nack->getInterest().getName().toUri()});
+}
+
+BOOST_AUTO_TEST_CASE(DeliveryOrder)
+{
+  Ptr<Node> node = CreateObject<Node>();
+  StackHelper ndnHelper;
+  ndnHelper.Install(node);
+
+  AppHelper appHelper("ns3::ndn::App");
+  Ptr<App> app = DynamicCast<App>(appHelper.Install(node).Get(0));
+
+  Deliveries deliveries;
+  app->TraceConnectWithoutContext("ReceivedInterests",
+                                  MakeBoundCallback(&onInterest, &deliveries));
+  app->TraceConnectWithoutContext("ReceivedDatas", MakeBoundCallback(&onData, &deliveries));
+  app->TraceConnectWithoutContext("ReceivedNacks", MakeBoundCallback(&onNack, &deliveries));
+
+  auto getAppFace = [node] {
+    for (auto& face : L3Protocol::getL3Protocol(node)->getForwarder()->getFaceTable()) {
+      if (face.getLocalUri().getScheme() == "appFace") {
+        return face.shared_from_this();
+      }
+    }
+    return shared_ptr<Face>();
+  };
+
+  // a burst sent by the forwarder within one event, as when satisfying several Interests
+  nfd::scheduler::schedule(time::seconds(1), [&] {
+      shared_ptr<Face> face = getAppFace();
+      BOOST_REQUIRE(face != nullptr);
+
+      face->sendInterest(*make_shared<Interest>("/a"));
+      face->sendData(*make_shared<Data>("/b"));
+      face->sendNack(lp::Nack(*make_shared<Interest>("/c")));
+      face->sendInterest(*make_shared<Interest>("/d"));
+
+      // still delivered from a separate event
+      BOOST_CHECK(deliveries.empty());
+    });
+
+  // a later event at the same time
+  nfd::scheduler::schedule(time::seconds(1), [&] {
+      getAppFace()->sendData(*make_shared<Data>("/e"));
+    });
+
+  nfd::scheduler::schedule(time::seconds(2), [&] {
+      getAppFace()->sendInterest(*make_shared<Interest>("/f"));
+    });
+
+  Simulator::Stop(Seconds(3));
+  Simulator::Run();
+
+  // every packet is delivered once, in the order it was sent, at the time it was sent
+  Deliveries expected = {
+    {Seconds(1), "Interest /a"},
+    {Seconds(1), "Data /b"},
+    {Seconds(1), "Nack /c"},
+    {Seconds(1), "Interest /d"},
+    {Seconds(1), "Data /e"},
+    {Seconds(2), "Interest /f"},
+  };
+  BOOST_REQUIRE_EQUAL(deliveries.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    BOOST_CHECK_EQUAL(deliveries[i].first, expected[i].first);
+    BOOST_CHECK_EQUAL(deliveries[i].second, expected[i].second);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
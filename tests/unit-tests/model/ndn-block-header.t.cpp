@@ -87,6 +87,48 @@ BOOST_AUTO_TEST_CASE(EncodePrintData)
   }
 }
 
+BOOST_AUTO_TEST_CASE(DeserializeData)
+{
+  Data data("/other/prefix");
+  data.setContent(std::make_shared< ::ndn::Buffer>(8000));
+  ndn::StackHelper::getKeyChain().sign(data);
+  lp::Packet lpPacket(data.wireEncode());
+  BlockHeader header(nfd::face::Transport::Packet(lpPacket.wireEncode()));
+
+  Ptr<Packet> packet = Create<Packet>();
+  packet->AddHeader(header);
+  // trailing bytes that do not belong to the block
+  packet->AddPaddingAtEnd(10);
+
+  BlockHeader decoded;
+  BOOST_CHECK_EQUAL(packet->RemoveHeader(decoded), header.GetSerializedSize());
+  BOOST_CHECK_EQUAL(packet->GetSize(), 10);
+
+  const Block& block = decoded.getBlock();
+  BOOST_CHECK_EQUAL_COLLECTIONS(block.begin(), block.end(),
+                                header.getBlock().begin(), header.getBlock().end());
+  lp::Packet decodedLp(block);
+  ::ndn::Buffer::const_iterator first, last;
+  std::tie(first, last) = decodedLp.get<lp::FragmentField>(0);
+  BOOST_CHECK_EQUAL(Data(Block(&*first, std::distance(first, last))), data);
+}
+
+BOOST_AUTO_TEST_CASE(DeserializeTruncated)
+{
+  Interest interest("/prefix");
+  interest.setNonce(10);
+  const Block& wire = interest.wireEncode();
+
+  Ptr<Packet> packet = Create<Packet>(wire.wire(), wire.size() - 1);
+  BlockHeader header;
+  BOOST_CHECK_THROW(packet->RemoveHeader(header), ::ndn::tlv::Error);
+
+  // TLV-LENGTH is a 4-octet number, but only 2 octets are available
+  const uint8_t badLength[] = {0x05, 0xFE, 0x00, 0x00};
+  packet = Create<Packet>(badLength, sizeof(badLength));
+  BOOST_CHECK_THROW(packet->RemoveHeader(header), ::ndn::tlv::Error);
+}
+
 BOOST_AUTO_TEST_CASE(PrintLpPacket)
 {
   Interest interest("/prefix");
@@ -0,0 +1,373 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-net-device-transport.hpp"
+#include "model/ndn-block-tag.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-mobility-routing-helper.hpp"
+#include "helper/ndn-app-helper.hpp"
+#include "NFD/core/scheduler.hpp"
+
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnNetDeviceTransport, ScenarioHelperWithCleanupFixture)
+
+static void
+countBytes(uint64_t* nBytes, Ptr<const ns3::Packet> packet)
+{
+  BlockTag tag;
+  BOOST_CHECK(packet->PeekPacketTag(tag));
+  *nBytes += packet->GetSize();
+}
+
+BOOST_AUTO_TEST_CASE(InMemoryPackets)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxPackets", UintegerValue(20));
+
+  getStackHelper().SetInMemoryPackets(true);
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "100s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  // NetDevice sees packets of the same size as the NFD packets
+  uint64_t nMacTxBytes = 0;
+  getNode("2")->GetDevice(0)->TraceConnectWithoutContext("MacTx", MakeBoundCallback(&countBytes,
+                                                                                   &nMacTxBytes));
+
+  nfd::scheduler::schedule(time::milliseconds(1050), [&] {
+      BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nInInterests, 11);
+      BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 11);
+      BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nOutBytes, nMacTxBytes);
+      BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInBytes, nMacTxBytes);
+    });
+
+  Simulator::Stop(Seconds(1.1));
+  Simulator::Run();
+}
+
+/**
+ * @brief Create two nodes connected by a link with 1.5 s delay, with a consumer on node 1 and
+ *        a producer on node 2, passing packets in memory
+ */
+static void
+createLongDelayScenario(ScenarioHelper& scenario)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1500ms"));
+
+  scenario.getStackHelper().SetInMemoryPackets(true);
+
+  scenario.createTopology({
+      {"1", "2"},
+    });
+
+  scenario.addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  scenario.addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"LifeTime", "10s"}},
+          "0s", "100s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+}
+
+BOOST_AUTO_TEST_CASE(InMemoryPacketsExpired)
+{
+  // blocks expire in flight with the default lifetime of 1 second, the packets are dropped
+  createLongDelayScenario(*this);
+
+  nfd::scheduler::schedule(time::milliseconds(4050), [&] {
+      BOOST_CHECK_GT(getFace("1", "2")->getCounters().nOutInterests, 10);
+      BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nInInterests, 0);
+      BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 0);
+    });
+
+  Simulator::Stop(Seconds(4.1));
+  Simulator::Run();
+}
+
+BOOST_AUTO_TEST_CASE(InMemoryPacketsLongDelay)
+{
+  Config::SetGlobal("NdnBlockLifetime", TimeValue(Seconds(2)));
+  createLongDelayScenario(*this);
+
+  // Interests sent in [0s, 1s] come back as Data in [3s, 4s] (retransmissions may add more)
+  nfd::scheduler::schedule(time::milliseconds(4050), [&] {
+      BOOST_CHECK_GE(getFace("2", "1")->getCounters().nInInterests, 26);
+      BOOST_CHECK_GE(getFace("1", "2")->getCounters().nInData, 11);
+    });
+
+  Simulator::Stop(Seconds(4.1));
+  Simulator::Run();
+  Config::SetGlobal("NdnBlockLifetime", TimeValue(Seconds(1)));
+}
+
+/**
+ * @brief Create an AP (node 0 of @p ap) and @p nStas STAs in its range, with unicast next hop
+ *        addressing, a producer of /prefix on the AP and consumers of /prefix on the STAs
+ */
+static void
+createInfrastructure(size_t nStas, NodeContainer& ap, NodeContainer& stas)
+{
+  ap.Create(1);
+  stas.Create(nStas);
+
+  WifiHelper wifi;
+  wifi.SetStandard(WIFI_PHY_STANDARD_80211a);
+  YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default();
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default();
+  wifiChannel.AddPropagationLoss("ns3::RangePropagationLossModel",
+                                 "MaxRange", DoubleValue(50.0));
+  wifiPhy.SetChannel(wifiChannel.Create());
+
+  NqosWifiMacHelper wifiMac = NqosWifiMacHelper::Default();
+  Ssid ssid("unicast");
+  wifiMac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+  wifi.Install(wifiPhy, wifiMac, ap);
+  wifiMac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
+  wifi.Install(wifiPhy, wifiMac, stas);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+  mobility.Install(ap);
+  mobility.Install(stas);
+  for (size_t i = 0; i < nStas; i++) {
+    stas.Get(i)->GetObject<MobilityModel>()->SetPosition(Vector(10.0 * (i + 1), 0.0, 0.0));
+  }
+
+  StackHelper ndnHelper;
+  ndnHelper.SetUnicastNextHop(WifiNetDevice::GetTypeId());
+  ndnHelper.Install(ap);
+  ndnHelper.Install(stas);
+
+  MobilityRoutingHelper mobilityRouting;
+  mobilityRouting.AddUplinkPrefix("/prefix", 1);
+  mobilityRouting.Install(stas);
+
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.Install(ap);
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", StringValue("10"));
+  consumerHelper.Install(stas);
+}
+
+static shared_ptr<Face>
+getDeviceFace(Ptr<Node> node)
+{
+  return L3Protocol::getL3Protocol(node)->getFaceByNetDevice(node->GetDevice(0));
+}
+
+/**
+ * @brief Get the face of @p ap to @p sta, or nullptr if there is none
+ */
+static shared_ptr<Face>
+getStaFace(Ptr<Node> ap, Ptr<Node> sta)
+{
+  std::ostringstream uri;
+  uri << "netdev://[" << Mac48Address::ConvertFrom(sta->GetDevice(0)->GetAddress()) << "]";
+
+  for (auto& face : L3Protocol::getL3Protocol(ap)->getForwarder()->getFaceTable()) {
+    if (face.getRemoteUri().toString() == uri.str()) {
+      return face.shared_from_this();
+    }
+  }
+  return nullptr;
+}
+
+static size_t
+countStaFaces(Ptr<Node> ap)
+{
+  size_t nFaces = 0;
+  for (const auto& face : L3Protocol::getL3Protocol(ap)->getForwarder()->getFaceTable()) {
+    if (face.getPersistency() == ::ndn::nfd::FACE_PERSISTENCY_ON_DEMAND &&
+        face.getLocalUri().getScheme() == "netdev") {
+      nFaces++;
+    }
+  }
+  return nFaces;
+}
+
+BOOST_AUTO_TEST_CASE(UnicastApWithoutStations)
+{
+  NodeContainer ap;
+  NodeContainer stas;
+  createInfrastructure(0, ap, stas);
+
+  // Interests from the AP itself can only go to the broadcast address
+  shared_ptr<Face> apFace = getDeviceFace(ap.Get(0));
+  FibHelper::AddRoute(ap.Get(0), "/downlink", apFace, 1);
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/downlink");
+  consumerHelper.SetAttribute("Frequency", StringValue("10"));
+  consumerHelper.Install(ap);
+
+  nfd::scheduler::schedule(time::milliseconds(1900), [&] {
+      BOOST_CHECK_EQUAL(countStaFaces(ap.Get(0)), 0);
+      BOOST_CHECK_GT(apFace->getCounters().nOutInterests, 0);
+    });
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+}
+
+BOOST_AUTO_TEST_CASE(UnicastApWithOneStation)
+{
+  NodeContainer ap;
+  NodeContainer stas;
+  createInfrastructure(1, ap, stas);
+
+  nfd::scheduler::schedule(time::milliseconds(1900), [&] {
+      BOOST_CHECK_EQUAL(countStaFaces(ap.Get(0)), 1);
+
+      // the STA sends to the BSSID, so its Interests arrive on its own face at the AP ...
+      shared_ptr<Face> staFace = getStaFace(ap.Get(0), stas.Get(0));
+      BOOST_REQUIRE(staFace != nullptr);
+      BOOST_CHECK_GT(staFace->getCounters().nInInterests, 0);
+
+      // ... which returns Data unicast, while the broadcast face of the AP stays unused
+      BOOST_CHECK_EQUAL(staFace->getCounters().nOutData, staFace->getCounters().nInInterests);
+      BOOST_CHECK_EQUAL(getDeviceFace(ap.Get(0))->getCounters().nInInterests, 0);
+      BOOST_CHECK_EQUAL(getDeviceFace(ap.Get(0))->getCounters().nOutData, 0);
+      BOOST_CHECK_GT(getDeviceFace(stas.Get(0))->getCounters().nInData, 0);
+    });
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+}
+
+BOOST_AUTO_TEST_CASE(UnicastApWithSeveralStations)
+{
+  NodeContainer ap;
+  NodeContainer stas;
+  createInfrastructure(3, ap, stas);
+
+  nfd::scheduler::schedule(time::milliseconds(1900), [&] {
+      BOOST_CHECK_EQUAL(countStaFaces(ap.Get(0)), 3);
+
+      // every STA gets the Data for its own Interests, and only them
+      for (size_t i = 0; i < stas.GetN(); i++) {
+        shared_ptr<Face> staFace = getStaFace(ap.Get(0), stas.Get(i));
+        BOOST_REQUIRE(staFace != nullptr);
+        BOOST_CHECK_GT(staFace->getCounters().nInInterests, 0);
+        BOOST_CHECK_EQUAL(staFace->getCounters().nOutData, staFace->getCounters().nInInterests);
+        BOOST_CHECK_EQUAL(getDeviceFace(stas.Get(i))->getCounters().nInData,
+                          staFace->getCounters().nOutData);
+      }
+      BOOST_CHECK_EQUAL(getDeviceFace(ap.Get(0))->getCounters().nOutData, 0);
+
+      // out of range of the AP, which will be noticed after missing its beacons
+      stas.Get(0)->GetObject<MobilityModel>()->SetPosition(Vector(1000.0, 0.0, 0.0));
+    });
+
+  // the face of the STA that left is closed, the others are kept
+  nfd::scheduler::schedule(time::milliseconds(5000), [&] {
+      BOOST_CHECK_EQUAL(countStaFaces(ap.Get(0)), 2);
+      BOOST_CHECK(getStaFace(ap.Get(0), stas.Get(0)) == nullptr);
+      BOOST_CHECK(getStaFace(ap.Get(0), stas.Get(1)) != nullptr);
+    });
+
+  Simulator::Stop(Seconds(5.1));
+  Simulator::Run();
+}
+
+BOOST_AUTO_TEST_CASE(UnicastStaHookedAfterAssociation)
+{
+  NodeContainer ap;
+  NodeContainer stas;
+  createInfrastructure(1, ap, stas);
+
+  // hooking the STA MAC up again once it is associated must not lose the association
+  uint64_t nInInterests = 0;
+  nfd::scheduler::schedule(time::milliseconds(1000), [&] {
+      BOOST_REQUIRE(stas.Get(0)->GetObject<WifiAssociation>()->IsAssociated());
+      shared_ptr<Face> staFace = getDeviceFace(stas.Get(0));
+      auto transport = dynamic_cast<NetDeviceTransport*>(staFace->getTransport());
+      BOOST_REQUIRE(transport != nullptr);
+      transport->SetUnicast(true);
+      nInInterests = getStaFace(ap.Get(0), stas.Get(0))->getCounters().nInInterests;
+    });
+
+  nfd::scheduler::schedule(time::milliseconds(1900), [&] {
+      BOOST_CHECK_GT(getStaFace(ap.Get(0), stas.Get(0))->getCounters().nInInterests, nInInterests);
+      BOOST_CHECK_EQUAL(getDeviceFace(ap.Get(0))->getCounters().nInInterests, 0);
+    });
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+}
+
+BOOST_AUTO_TEST_CASE(UnicastStaWhileNotAssociated)
+{
+  NodeContainer ap;
+  NodeContainer stas;
+  createInfrastructure(1, ap, stas);
+
+  // out of range from the start, the STA never associates
+  stas.Get(0)->GetObject<MobilityModel>()->SetPosition(Vector(1000.0, 0.0, 0.0));
+  shared_ptr<Face> face = getDeviceFace(stas.Get(0));
+  FibHelper::AddRoute(stas.Get(0), "/prefix", face, 1);
+
+  nfd::scheduler::schedule(time::milliseconds(1900), [&] {
+      BOOST_CHECK(!stas.Get(0)->GetObject<WifiAssociation>()->IsAssociated());
+      BOOST_CHECK_GT(face->getCounters().nOutInterests, 0);
+      BOOST_CHECK_EQUAL(countStaFaces(ap.Get(0)), 0);
+      BOOST_CHECK_EQUAL(getDeviceFace(ap.Get(0))->getCounters().nInInterests, 0);
+    });
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -18,6 +18,10 @@
  **/
 
 
+#include "model/cs/speculative-requests.hpp"
+
+#include <ndn-cxx/lp/tags.hpp>
+
 #include "../tests-common.hpp"
 
 namespace ns3 {
@@ -25,6 +29,27 @@ namespace ndn {
 
 BOOST_FIXTURE_TEST_SUITE(ModelNdnOldContentStore, ScenarioHelperWithCleanupFixture)
 
+static shared_ptr<Data>
+makeData(const Name& name, size_t contentSize)
+{
+  auto data = make_shared<Data>(name);
+  std::vector<uint8_t> content(contentSize);
+  data->setContent(content.data(), content.size());
+  return data;
+}
+
+static void
+saveBytes(uint64_t* bytes, uint64_t oldValue, uint64_t newValue)
+{
+  *bytes = newValue;
+}
+
+static void
+countEntry(int* count, Ptr<const cs::Entry> entry)
+{
+  ++*count;
+}
+
 BOOST_AUTO_TEST_CASE(RandomPolicy)
 {
   Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
@@ -67,6 +92,178 @@ BOOST_AUTO_TEST_CASE(RandomPolicy)
   BOOST_CHECK(entries["1"] != entries["2"]); // this test has a small chance of failing
 }
 
+BOOST_AUTO_TEST_CASE(LookupReturnsCopy)
+{
+  ObjectFactory factory("ns3::ndn::cs::Lru");
+  Ptr<ContentStore> cs = factory.Create<ContentStore>();
+
+  auto data = make_shared<Data>("/prefix/1");
+  BOOST_CHECK(cs->Add(data));
+
+  // the caller gets a modifiable copy, and what it does with it must not leak into later hits
+  shared_ptr<Data> copy = cs->Lookup(make_shared<Interest>("/prefix"));
+  BOOST_REQUIRE(copy != nullptr);
+  BOOST_CHECK(copy != data);
+  BOOST_CHECK_EQUAL(copy->getName(), data->getName());
+  copy->setTag(make_shared<lp::IncomingFaceIdTag>(1));
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/prefix/1"))->getTag<lp::IncomingFaceIdTag>()
+              == nullptr);
+  BOOST_CHECK(data->getTag<lp::IncomingFaceIdTag>() == nullptr);
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/other")) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(NameIndex)
+{
+  for (const std::string& nameIndex : {"false", "true"}) {
+    ObjectFactory factory("ns3::ndn::cs::Lru");
+    factory.Set("MaxSize", StringValue("2"));
+    factory.Set("NameIndex", StringValue(nameIndex));
+    Ptr<ContentStore> cs = factory.Create<ContentStore>();
+
+    BOOST_CHECK(cs->Add(make_shared<Data>("/prefix/1")));
+    BOOST_CHECK(!cs->Add(make_shared<Data>("/prefix/1"))); // duplicate
+    BOOST_CHECK(cs->Add(make_shared<Data>("/prefix/2")));
+    BOOST_CHECK(cs->Lookup(make_shared<Interest>("/prefix/1")) != nullptr);
+
+    // /prefix/2 is the least recently used entry now
+    BOOST_CHECK(cs->Add(make_shared<Data>("/prefix/3")));
+    BOOST_CHECK_EQUAL(cs->GetSize(), 2);
+    BOOST_CHECK(cs->Lookup(make_shared<Interest>("/prefix/2")) == nullptr);
+    BOOST_CHECK(cs->Lookup(make_shared<Interest>("/prefix/3")) != nullptr);
+    BOOST_CHECK(cs->Lookup(make_shared<Interest>("/prefix")) != nullptr);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MaxBytes)
+{
+  ObjectFactory factory("ns3::ndn::cs::Lru");
+  factory.Set("MaxSize", StringValue("0"));
+  factory.Set("MaxBytes", StringValue("10000"));
+  Ptr<ContentStore> cs = factory.Create<ContentStore>();
+
+  uint64_t occupiedBytes = 0;
+  cs->TraceConnectWithoutContext("OccupiedBytes", MakeBoundCallback(&saveBytes, &occupiedBytes));
+
+  BOOST_CHECK(cs->Add(makeData("/video/1", 8000)));
+  BOOST_CHECK(cs->Add(makeData("/segment/1", 1000)));
+  BOOST_CHECK_GT(occupiedBytes, 9000);
+
+  // the 8 KB chunk is the least recently used entry and has to go
+  BOOST_CHECK(cs->Add(makeData("/segment/2", 1000)));
+  BOOST_CHECK_EQUAL(cs->GetSize(), 2);
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/video/1")) == nullptr);
+  BOOST_CHECK_GT(occupiedBytes, 2000);
+  BOOST_CHECK_LT(occupiedBytes, 3000);
+
+  // Data larger than the whole budget is not cached and does not evict anything
+  BOOST_CHECK(!cs->Add(makeData("/video/2", 20000)));
+  BOOST_CHECK_EQUAL(cs->GetSize(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(WTinyLfuResistsScans)
+{
+  ObjectFactory factory("ns3::ndn::cs::WTinyLfu");
+  factory.Set("MaxSize", StringValue("10"));
+  Ptr<ContentStore> cs = factory.Create<ContentStore>();
+  auto popular = [] (uint64_t i) { return Name("/popular").appendNumber(i); };
+
+  for (uint64_t i = 0; i < 5; i++) {
+    BOOST_CHECK(cs->Add(make_shared<Data>(popular(i))));
+  }
+  for (int round = 0; round < 3; round++) {
+    for (uint64_t i = 0; i < 5; i++) {
+      BOOST_CHECK(cs->Lookup(make_shared<Interest>(popular(i))) != nullptr);
+    }
+  }
+
+  // a long sequential scan of one-time segments
+  for (uint64_t i = 0; i < 100; i++) {
+    cs->Add(make_shared<Data>(Name("/scan").appendNumber(i)));
+  }
+
+  BOOST_CHECK_LE(cs->GetSize(), 10);
+  for (uint64_t i = 0; i < 5; i++) {
+    BOOST_CHECK(cs->Lookup(make_shared<Interest>(popular(i))) != nullptr);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PrefetchClasses)
+{
+  ObjectFactory factory("ns3::ndn::cs::Prefetch::Lru");
+  factory.Set("MaxSize", StringValue("3"));
+  Ptr<ContentStore> cs = factory.Create<ContentStore>();
+
+  int nHits = 0;
+  int nWasted = 0;
+  cs->TraceConnectWithoutContext("PrefetchHit", MakeBoundCallback(&countEntry, &nHits));
+  cs->TraceConnectWithoutContext("PrefetchWasted", MakeBoundCallback(&countEntry, &nWasted));
+
+  // the record belongs to the store of the node
+  Ptr<Node> node = CreateObject<Node>();
+  node->AggregateObject(cs);
+  cs::SpeculativeRequests* requests = cs::SpeculativeRequests::Get(node);
+  BOOST_REQUIRE(requests != nullptr);
+  requests->Register("/video/3", Seconds(1));
+  requests->Register("/video/4", Seconds(1));
+  requests->Register("/video/5", Seconds(1));
+
+  BOOST_CHECK(cs->Add(make_shared<Data>("/video/1")));
+  BOOST_CHECK(cs->Add(make_shared<Data>("/video/2")));
+  BOOST_CHECK(cs->Add(make_shared<Data>("/video/3")));
+
+  // never-hit speculative /video/3 goes first, even though /video/1 is least recently used
+  BOOST_CHECK(cs->Add(make_shared<Data>("/video/4")));
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/video/3")) == nullptr);
+  BOOST_CHECK_EQUAL(nWasted, 1);
+
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/video/1")) != nullptr);
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/video/2")) != nullptr);
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/video/4")) != nullptr);
+  BOOST_CHECK_EQUAL(nHits, 1);
+
+  // /video/4 is a demand entry now, so plain LRU order applies
+  BOOST_CHECK(cs->Add(make_shared<Data>("/video/5")));
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/video/1")) == nullptr);
+  BOOST_CHECK_EQUAL(nWasted, 1);
+
+  BOOST_CHECK(cs->Add(make_shared<Data>("/video/6")));
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/video/5")) == nullptr);
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/video/4")) != nullptr);
+  BOOST_CHECK_EQUAL(cs->GetSize(), 3);
+  BOOST_CHECK_EQUAL(nWasted, 2);
+}
+
+BOOST_AUTO_TEST_CASE(PrefetchClassesPerNode)
+{
+  ObjectFactory factory("ns3::ndn::cs::Prefetch::Lru");
+  Ptr<ContentStore> cs = factory.Create<ContentStore>();
+  Ptr<Node> node = CreateObject<Node>();
+  node->AggregateObject(cs);
+
+  ObjectFactory otherFactory("ns3::ndn::cs::Prefetch::Lru");
+  Ptr<ContentStore> otherCs = otherFactory.Create<ContentStore>();
+  Ptr<Node> otherNode = CreateObject<Node>();
+  otherNode->AggregateObject(otherCs);
+
+  ObjectFactory plainFactory("ns3::ndn::cs::Lru");
+  Ptr<Node> plainNode = CreateObject<Node>();
+  plainNode->AggregateObject(plainFactory.Create<ContentStore>());
+
+  // nodes without a store with prefetch classes keep no record
+  BOOST_CHECK(cs::SpeculativeRequests::Get(plainNode) == nullptr);
+  BOOST_CHECK(cs::SpeculativeRequests::Get(CreateObject<Node>()) == nullptr);
+
+  cs::SpeculativeRequests::Get(node)->Register("/video/1", Seconds(1));
+
+  BOOST_CHECK(cs->Add(make_shared<Data>("/video/1")));
+  BOOST_CHECK(otherCs->Add(make_shared<Data>("/video/1")));
+  boost::test_tools::output_test_stream os;
+  os << *cs;
+  BOOST_CHECK(os.is_equal("/video/1 (speculative)\n"));
+  os << *otherCs;
+  BOOST_CHECK(os.is_equal("/video/1\n"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
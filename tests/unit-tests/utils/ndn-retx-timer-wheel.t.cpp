@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-retx-timer-wheel.hpp"
+
+#include "ns3/simulator.h"
+
+#include <vector>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class RetxTimerWheelFixture : public CleanupFixture
+{
+public:
+  RetxTimerWheelFixture()
+    : rto(MilliSeconds(100))
+    , nRtoQueries(0)
+    , wheel([this] {
+                ++nRtoQueries;
+                return rto;
+              },
+            [this] (uint32_t seq) { timeouts.push_back(std::make_pair(seq, Simulator::Now())); },
+            8)
+  {
+    wheel.SetGranularity(MilliSeconds(10));
+  }
+
+  void
+  advance(Time delay)
+  {
+    Simulator::Stop(delay);
+    Simulator::Run();
+  }
+
+public:
+  Time rto;
+  // every wheel tick asks for the current RTO exactly once, so this counts processed ticks
+  size_t nRtoQueries;
+  std::vector<std::pair<uint32_t, Time>> timeouts;
+  RetxTimerWheel wheel;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnRetxTimerWheel, RetxTimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(InsertCancelRearm)
+{
+  BOOST_CHECK(wheel.Insert(1, Simulator::Now()));
+  BOOST_CHECK(!wheel.Insert(1, Simulator::Now())); // already tracked
+  BOOST_CHECK(wheel.Insert(2, Simulator::Now()));
+  BOOST_CHECK_EQUAL(wheel.size(), 2);
+
+  BOOST_CHECK_EQUAL(wheel.Erase(2), 1);
+  BOOST_CHECK_EQUAL(wheel.Erase(2), 0);
+
+  advance(MilliSeconds(150));
+  BOOST_REQUIRE_EQUAL(timeouts.size(), 1);
+  BOOST_CHECK_EQUAL(timeouts[0].first, 1);
+  BOOST_CHECK_EQUAL(timeouts[0].second, MilliSeconds(100));
+  BOOST_CHECK(wheel.empty());
+
+  // the wheel is re-armed by the first insert after it became empty
+  BOOST_CHECK(wheel.Insert(3, Simulator::Now()));
+  advance(MilliSeconds(200));
+  BOOST_REQUIRE_EQUAL(timeouts.size(), 2);
+  BOOST_CHECK_EQUAL(timeouts[1].first, 3);
+  BOOST_CHECK_EQUAL(timeouts[1].second, MilliSeconds(250));
+
+  // and the sequence number can be tracked again after its timeout
+  BOOST_CHECK(wheel.Insert(1, Simulator::Now()));
+  wheel.Clear();
+  advance(MilliSeconds(200));
+  BOOST_CHECK_EQUAL(timeouts.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(RtoGrowth)
+{
+  wheel.Insert(1, Simulator::Now());
+  advance(MilliSeconds(50));
+
+  // timeout is checked against the RTO at expiration time, not at insertion time
+  rto = MilliSeconds(300);
+  advance(MilliSeconds(200));
+  BOOST_CHECK(timeouts.empty());
+
+  advance(MilliSeconds(100));
+  BOOST_REQUIRE_EQUAL(timeouts.size(), 1);
+  BOOST_CHECK_EQUAL(timeouts[0].second, MilliSeconds(300));
+}
+
+BOOST_AUTO_TEST_CASE(SeveralTurns)
+{
+  // 8 slots of 10ms: one turn of the wheel is 80ms, RTO spans more than 12 turns
+  rto = Seconds(1);
+
+  wheel.Insert(1, Simulator::Now());
+  advance(MilliSeconds(35));
+  wheel.Insert(2, Simulator::Now());
+  advance(MilliSeconds(45));
+  wheel.Insert(3, Simulator::Now()); // lands in the same slot as 1, 8 ticks later
+
+  advance(MilliSeconds(1100));
+  BOOST_REQUIRE_EQUAL(timeouts.size(), 3);
+  BOOST_CHECK_EQUAL(timeouts[0].first, 1);
+  BOOST_CHECK_EQUAL(timeouts[0].second, MilliSeconds(1000));
+  BOOST_CHECK_EQUAL(timeouts[1].first, 2);
+  BOOST_CHECK_EQUAL(timeouts[1].second, MilliSeconds(1040));
+  BOOST_CHECK_EQUAL(timeouts[2].first, 3);
+  BOOST_CHECK_EQUAL(timeouts[2].second, MilliSeconds(1080));
+}
+
+BOOST_AUTO_TEST_CASE(SingleArmedEvent)
+{
+  rto = Seconds(10);
+
+  // nothing is outstanding, nothing ticks
+  advance(Seconds(1));
+  BOOST_CHECK_EQUAL(nRtoQueries, 0);
+
+  // one tick per 10ms, no matter how many entries are outstanding or how they came and went
+  for (uint32_t seq = 0; seq < 100; seq++) {
+    wheel.Insert(seq, Simulator::Now());
+  }
+  wheel.Erase(5);
+  wheel.Insert(5, Simulator::Now());
+  nRtoQueries = 0;
+  advance(MilliSeconds(1005)); // stay clear of a tick at the end of the window
+  BOOST_CHECK_EQUAL(nRtoQueries, 100);
+  advance(MilliSeconds(5));
+
+  // cancel everything and start over: the old tick event must not survive
+  for (uint32_t seq = 0; seq < 100; seq++) {
+    wheel.Erase(seq);
+  }
+  BOOST_CHECK(wheel.empty());
+  nRtoQueries = 0;
+  wheel.Insert(1000, Simulator::Now());
+  advance(MilliSeconds(1005));
+  BOOST_CHECK_EQUAL(nRtoQueries, 1 + 100);
+
+  wheel.Erase(1000);
+  nRtoQueries = 0;
+  advance(Seconds(1));
+  BOOST_CHECK_EQUAL(nRtoQueries, 0);
+  BOOST_CHECK(timeouts.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
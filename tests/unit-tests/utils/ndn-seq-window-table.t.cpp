@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-seq-window-table.hpp"
+
+#include <map>
+#include <random>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnSeqWindowTable)
+
+BOOST_AUTO_TEST_CASE(Growth)
+{
+  SeqWindowTable table(4);
+  for (uint32_t seq = 0; seq < 100; seq++) {
+    table.Get(seq).retxCount = seq;
+  }
+
+  BOOST_CHECK_EQUAL(table.size(), 100);
+  BOOST_CHECK_EQUAL(table.GetBase(), 0);
+  for (uint32_t seq = 0; seq < 100; seq++) {
+    BOOST_REQUIRE(table.Find(seq) != nullptr);
+    BOOST_CHECK_EQUAL(table.Find(seq)->retxCount, seq);
+  }
+  BOOST_CHECK(table.Find(100) == nullptr);
+
+  // a gap is covered by the window, but the skipped sequence numbers are not in use
+  table.Get(1000).retxCount = 1000;
+  BOOST_CHECK_EQUAL(table.size(), 101);
+  BOOST_CHECK(table.Find(500) == nullptr);
+  BOOST_CHECK_EQUAL(table.Find(1000)->retxCount, 1000);
+  BOOST_CHECK_EQUAL(table.Find(99)->retxCount, 99);
+}
+
+BOOST_AUTO_TEST_CASE(BackwardExtension)
+{
+  SeqWindowTable table(4);
+  table.Get(100).retxCount = 100;
+  table.Get(102).retxCount = 102;
+  BOOST_CHECK_EQUAL(table.GetBase(), 100);
+
+  table.Get(90).retxCount = 90;
+  BOOST_CHECK_EQUAL(table.GetBase(), 90);
+  BOOST_CHECK_EQUAL(table.size(), 3);
+  BOOST_CHECK(table.Find(95) == nullptr);
+  BOOST_CHECK(table.Find(89) == nullptr);
+  BOOST_CHECK_EQUAL(table.Find(90)->retxCount, 90);
+  BOOST_CHECK_EQUAL(table.Find(100)->retxCount, 100);
+  BOOST_CHECK_EQUAL(table.Find(102)->retxCount, 102);
+
+  // releasing the new front slides the window back to the next entry in use
+  table.Release(90);
+  BOOST_CHECK_EQUAL(table.GetBase(), 100);
+  BOOST_CHECK_EQUAL(table.Find(102)->retxCount, 102);
+}
+
+BOOST_AUTO_TEST_CASE(Sliding)
+{
+  SeqWindowTable table(8);
+  for (uint32_t seq = 0; seq < 10; seq++) {
+    table.Get(seq).retxCount = seq;
+  }
+
+  table.Release(0);
+  BOOST_CHECK_EQUAL(table.GetBase(), 1);
+  table.Release(2); // not at the front, the window stays
+  BOOST_CHECK_EQUAL(table.GetBase(), 1);
+  BOOST_CHECK(table.Find(2) == nullptr);
+  table.Release(1);
+  BOOST_CHECK_EQUAL(table.GetBase(), 3);
+  BOOST_CHECK_EQUAL(table.size(), 7);
+
+  // playback releases segments a few positions behind the newest request; the ring buffer wraps
+  // around many times without growing
+  for (uint32_t seq = 10; seq < 10000; seq++) {
+    table.Get(seq).retxCount = seq;
+    table.Release(seq - 7);
+    BOOST_CHECK_EQUAL(table.GetBase(), seq - 6);
+    BOOST_CHECK_EQUAL(table.Find(seq - 6)->retxCount, seq - 6);
+  }
+  BOOST_CHECK_EQUAL(table.size(), 7);
+
+  // empty window restarts at any sequence number
+  for (uint32_t seq = 9993; seq < 10000; seq++) {
+    table.Release(seq);
+  }
+  BOOST_CHECK_EQUAL(table.size(), 0);
+  table.Get(5);
+  BOOST_CHECK_EQUAL(table.GetBase(), 5);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(RandomOrder)
+{
+  // Zipf-like access: random sequence numbers over a large catalogue, few of them in use
+  SeqWindowTable table;
+  std::map<uint32_t, uint32_t> expected;
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<uint32_t> catalogue(1, 100000);
+  std::vector<uint32_t> inUse;
+
+  for (int i = 0; i < 20000; i++) {
+    uint32_t seq = catalogue(rng);
+    table.Get(seq).retxCount = seq;
+    if (expected.insert(std::make_pair(seq, seq)).second) {
+      inUse.push_back(seq);
+    }
+
+    if (inUse.size() > 32) {
+      size_t victim = rng() % inUse.size();
+      table.Release(inUse[victim]);
+      expected.erase(inUse[victim]);
+      inUse[victim] = inUse.back();
+      inUse.pop_back();
+    }
+
+    BOOST_REQUIRE_EQUAL(table.size(), expected.size());
+    // the buffer is never stretched over the catalogue
+    BOOST_REQUIRE_LE(table.GetCapacity(), 1024);
+  }
+  BOOST_CHECK(table.IsSparse());
+  BOOST_CHECK_EQUAL(table.GetBase(), expected.begin()->first);
+
+  for (uint32_t seq = 1; seq <= 100000; seq++) {
+    SeqWindowTable::Entry* entry = table.Find(seq);
+    BOOST_REQUIRE_EQUAL(entry != nullptr, expected.count(seq) == 1);
+    if (entry != nullptr) {
+      BOOST_CHECK_EQUAL(entry->retxCount, seq);
+    }
+  }
+
+  // once empty, the table is a window again
+  for (uint32_t seq : inUse) {
+    table.Release(seq);
+  }
+  BOOST_CHECK_EQUAL(table.size(), 0);
+  BOOST_CHECK(!table.IsSparse());
+  for (uint32_t seq = 500; seq < 600; seq++) {
+    table.Get(seq);
+  }
+  BOOST_CHECK(!table.IsSparse());
+  BOOST_CHECK_EQUAL(table.GetBase(), 500);
+}
+
+BOOST_AUTO_TEST_CASE(Flags)
+{
+  SeqWindowTable table;
+
+  SeqWindowTable::Entry& entry = table.Get(5);
+  BOOST_CHECK_EQUAL(entry.flags, SeqWindowTable::IN_USE);
+  entry.flags |= SeqWindowTable::PENDING;
+  entry.retxCount++;
+
+  // retransmission timeout
+  table.Get(5).flags |= SeqWindowTable::RETX;
+  table.Get(5).retxCount++;
+  BOOST_CHECK_EQUAL(table.Find(5)->flags,
+                    SeqWindowTable::IN_USE | SeqWindowTable::PENDING | SeqWindowTable::RETX);
+  BOOST_CHECK_EQUAL(table.Find(5)->retxCount, 2);
+
+  // Data arrives, the entry is kept for the playback
+  table.Find(5)->flags = SeqWindowTable::IN_USE | SeqWindowTable::RECEIVED;
+  BOOST_CHECK(!(table.Find(5)->flags & SeqWindowTable::RETX));
+  BOOST_CHECK(table.Find(5)->flags & SeqWindowTable::RECEIVED);
+
+  // displayed and released; reuse starts from a clean entry
+  table.Release(5);
+  BOOST_CHECK(table.Find(5) == nullptr);
+  table.Release(5); // no-op
+  BOOST_CHECK_EQUAL(table.size(), 0);
+  BOOST_CHECK_EQUAL(table.Get(5).flags, SeqWindowTable::IN_USE);
+  BOOST_CHECK_EQUAL(table.Get(5).retxCount, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,258 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/trie/trie.hpp"
+
+#include <set>
+#include <sstream>
+#include <string>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ndnSIM::trie;
+using ndnSIM::non_pointer_traits;
+using ndnSIM::pool_allocator;
+
+BOOST_AUTO_TEST_SUITE(UtilsTrie)
+
+struct NoPolicyHook
+{
+};
+
+typedef trie<Name, non_pointer_traits<int>, NoPolicyHook> Trie;
+
+class TrieFixture
+{
+public:
+  TrieFixture()
+    : root(name::Component(), allocator)
+  {
+  }
+
+  Trie::iterator
+  insert(const std::string& name, int payload)
+  {
+    return root.insert(Name(name), payload).first;
+  }
+
+  /**
+   * @brief Get payloads of all nodes in recursive_iterator order, 0 for nodes without payload
+   */
+  std::multiset<int>
+  collect()
+  {
+    std::multiset<int> payloads;
+    for (Trie::recursive_iterator node(root), end(0); node != end; node++) {
+      payloads.insert(node->payload());
+    }
+    return payloads;
+  }
+
+  /**
+   * @brief Get the second line of PrintStat of @p node: " inline", or sizes of its buckets
+   */
+  static std::string
+  childStorage(const Trie& node)
+  {
+    std::ostringstream os;
+    node.PrintStat(os);
+    std::istringstream is(os.str());
+    std::string line;
+    std::getline(is, line);
+    std::getline(is, line);
+    return line;
+  }
+
+  static size_t
+  countBuckets(const Trie& node)
+  {
+    std::istringstream is(childStorage(node));
+    size_t nBuckets = 0;
+    size_t bucketSize;
+    while (is >> bucketSize) {
+      nBuckets++;
+    }
+    return nBuckets;
+  }
+
+public:
+  Trie::allocator_type allocator; // must outlive root
+  Trie root;
+};
+
+BOOST_FIXTURE_TEST_CASE(InlineToHashed, TrieFixture)
+{
+  for (int i = 1; i <= static_cast<int>(Trie::INLINE_CHILDREN); i++) {
+    insert("/" + std::to_string(i), i);
+  }
+  BOOST_CHECK_EQUAL(childStorage(root), " inline");
+
+  // one more child moves all of them into a hashed set with twice as many buckets
+  insert("/5", 5);
+  BOOST_CHECK_EQUAL(countBuckets(root), 2 * Trie::INLINE_CHILDREN);
+
+  // which doubles whenever it gets full
+  for (int i = 6; i <= 17; i++) {
+    insert("/" + std::to_string(i), i);
+  }
+  BOOST_CHECK_EQUAL(countBuckets(root), 32);
+
+  std::multiset<int> expected = {0};
+  for (int i = 1; i <= 17; i++) {
+    Trie::iterator node = std::get<0>(root.find(Name("/" + std::to_string(i))));
+    BOOST_REQUIRE(node != root.end());
+    BOOST_CHECK_EQUAL(node->payload(), i);
+    expected.insert(i);
+  }
+  BOOST_CHECK(std::get<0>(root.find(Name("/18"))) == root.end());
+  BOOST_CHECK(collect() == expected);
+
+  // an existing child is found rather than added
+  BOOST_CHECK(!root.insert(Name("/9"), 99).second);
+  BOOST_CHECK(collect() == expected);
+}
+
+BOOST_FIXTURE_TEST_CASE(EraseDuringTraversal, TrieFixture)
+{
+  // /a has inline children, /b hashed ones, and some nodes have children of their own
+  for (int i = 1; i <= 4; i++) {
+    insert("/a/" + std::to_string(i), 10 + i);
+  }
+  insert("/a/2/x", 100);
+  for (int i = 1; i <= 10; i++) {
+    insert("/b/" + std::to_string(i), 20 + i);
+  }
+  BOOST_CHECK_EQUAL(childStorage(*std::get<2>(root.find(Name("/a")))), " inline");
+
+  // remove children in the middle of the inline array, and every other hashed child
+  std::set<int> visited;
+  root.clear_if([&visited] (const Trie& node) {
+      visited.insert(node.payload());
+      int payload = node.payload();
+      return payload == 12 || payload == 13 || (payload > 20 && payload <= 30 && payload % 2 == 0);
+    });
+
+  for (int payload : {11, 12, 13, 14, 100, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30}) {
+    BOOST_CHECK_MESSAGE(visited.count(payload) == 1, "node " << payload << " was skipped");
+  }
+  BOOST_CHECK(collect() == std::multiset<int>({0, 0, 0, 0, 11, 14, 100, 21, 23, 25, 27, 29}));
+
+  // /a/2 keeps its child, /a/3 is gone
+  BOOST_CHECK(std::get<0>(root.find(Name("/a/2/x"))) != root.end());
+  BOOST_CHECK(std::get<1>(root.find(Name("/a/2"))));
+  BOOST_CHECK(!std::get<1>(root.find(Name("/a/3"))));
+}
+
+BOOST_FIXTURE_TEST_CASE(PruneAfterHashed, TrieFixture)
+{
+  std::vector<Trie::iterator> nodes;
+  for (int i = 1; i <= 10; i++) {
+    nodes.push_back(insert("/a/" + std::to_string(i), i));
+  }
+
+  for (Trie::iterator node : nodes) {
+    node->erase();
+  }
+
+  // /a is pruned together with its last child and the hashed set
+  BOOST_CHECK(root.find() == root.end());
+  BOOST_CHECK(!std::get<1>(root.find(Name("/a"))));
+  BOOST_CHECK(collect() == std::multiset<int>({0}));
+
+  // and can be recreated
+  insert("/a/1", 1);
+  BOOST_CHECK_EQUAL(childStorage(*std::get<2>(root.find(Name("/a")))), " inline");
+  BOOST_CHECK(collect() == std::multiset<int>({0, 0, 1}));
+}
+
+BOOST_FIXTURE_TEST_CASE(PoolReuse, TrieFixture)
+{
+  // /video has hashed children that stay, /audio only the one being replaced
+  for (int i = 1; i <= 10; i++) {
+    insert("/video/" + std::to_string(i), i);
+  }
+
+  // insert and evict at a constant size, as a full content store does
+  std::set<const Trie*> videoNodes;
+  std::set<const Trie*> audioNodes;
+  for (int i = 11; i <= 200; i++) {
+    Trie::iterator node = insert("/video/" + std::to_string(i), i);
+    videoNodes.insert(node);
+    node->erase();
+
+    node = insert("/audio/" + std::to_string(i), i);
+    audioNodes.insert(node);
+    audioNodes.insert(node->parent());
+    node->erase();
+  }
+
+  // freed nodes are handed out again by the next insert
+  BOOST_CHECK_EQUAL(videoNodes.size(), 1);
+  BOOST_CHECK_EQUAL(audioNodes.size(), 2);
+  BOOST_CHECK_EQUAL(countBuckets(*std::get<2>(root.find(Name("/video")))), 16);
+}
+
+BOOST_AUTO_TEST_CASE(PoolAllocatorFreeLists)
+{
+  struct Node
+  {
+    void* data[12];
+  };
+  pool_allocator<Node, void*> allocator;
+
+  // nodes are recycled in LIFO order
+  void* node1 = allocator.allocate_node();
+  void* node2 = allocator.allocate_node();
+  BOOST_CHECK(node1 != node2);
+  allocator.deallocate_node(node1);
+  BOOST_CHECK(allocator.allocate_node() == node1);
+
+  // bucket arrays and other blocks come from free lists by power of two size
+  void** buckets = allocator.allocate_buckets(8);
+  for (size_t i = 0; i < 8; i++) {
+    BOOST_CHECK(buckets[i] == nullptr);
+    buckets[i] = node2;
+  }
+  allocator.deallocate_buckets(buckets, 8);
+  void** smallerBuckets = allocator.allocate_buckets(5);
+  BOOST_CHECK(smallerBuckets == buckets);
+  BOOST_CHECK(smallerBuckets[0] == nullptr);
+
+  void* block = allocator.allocate_memory(48);
+  allocator.deallocate_memory(block, 48);
+  BOOST_CHECK(allocator.allocate_memory(64) == block);
+  void* otherBlock = allocator.allocate_memory(64);
+  BOOST_CHECK(otherBlock != block);
+
+  // 5 buckets are in the same size class as 8
+  allocator.deallocate_buckets(smallerBuckets, 5);
+  BOOST_CHECK(allocator.allocate_memory(64) == smallerBuckets);
+
+  allocator.deallocate_memory(smallerBuckets, 64);
+  allocator.deallocate_memory(otherBlock, 64);
+  allocator.deallocate_memory(block, 64);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
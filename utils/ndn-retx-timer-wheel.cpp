@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-retx-timer-wheel.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.RetxTimerWheel");
+
+namespace ns3 {
+namespace ndn {
+
+const size_t RetxTimerWheel::NONE = std::numeric_limits<size_t>::max();
+
+RetxTimerWheel::RetxTimerWheel(const RtoCallback& getRto, const TimeoutCallback& onTimeout,
+                               size_t nSlots)
+  : m_getRto(getRto)
+  , m_onTimeout(onTimeout)
+  , m_granularity(MilliSeconds(200))
+  , m_slots(nSlots, NONE)
+  , m_currentTick(0)
+{
+  NS_ASSERT(nSlots > 0);
+}
+
+RetxTimerWheel::~RetxTimerWheel()
+{
+  m_tickEvent.Cancel();
+}
+
+void
+RetxTimerWheel::SetGranularity(Time granularity)
+{
+  NS_ASSERT(granularity.IsStrictlyPositive());
+
+  // re-bucket outstanding entries according to the new slot duration
+  std::vector<std::pair<uint32_t, Time>> outstanding;
+  for (const auto& item : m_index) {
+    outstanding.push_back(std::make_pair(item.first, m_entries[item.second].sendTime));
+  }
+  Clear();
+
+  m_granularity = granularity;
+  for (const auto& item : outstanding) {
+    Insert(item.first, item.second);
+  }
+}
+
+bool
+RetxTimerWheel::Insert(uint32_t seq, Time sendTime)
+{
+  if (m_index.find(seq) != m_index.end())
+    return false;
+
+  if (m_index.empty()) {
+    Arm();
+  }
+
+  size_t pos;
+  if (!m_free.empty()) {
+    pos = m_free.back();
+    m_free.pop_back();
+  }
+  else {
+    pos = m_entries.size();
+    m_entries.push_back(Entry());
+  }
+
+  m_entries[pos].seq = seq;
+  m_entries[pos].sendTime = sendTime;
+  m_index[seq] = pos;
+  Link(pos, sendTime + m_getRto());
+  return true;
+}
+
+size_t
+RetxTimerWheel::Erase(uint32_t seq)
+{
+  auto it = m_index.find(seq);
+  if (it == m_index.end())
+    return 0;
+
+  Unlink(it->second);
+  m_free.push_back(it->second);
+  m_index.erase(it);
+
+  if (m_index.empty()) {
+    m_tickEvent.Cancel();
+  }
+  return 1;
+}
+
+void
+RetxTimerWheel::Clear()
+{
+  m_tickEvent.Cancel();
+  m_index.clear();
+  m_entries.clear();
+  m_free.clear();
+  std::fill(m_slots.begin(), m_slots.end(), NONE);
+}
+
+void
+RetxTimerWheel::Link(size_t pos, Time deadline)
+{
+  // the entry must land on a tick that has not been processed yet
+  int64_t tick = (deadline.GetTimeStep() + m_granularity.GetTimeStep() - 1) / m_granularity.GetTimeStep();
+  tick = std::max(tick, m_currentTick + 1);
+
+  Entry& entry = m_entries[pos];
+  size_t& head = m_slots[tick % m_slots.size()];
+  entry.tick = tick;
+  entry.prev = NONE;
+  entry.next = head;
+  if (head != NONE) {
+    m_entries[head].prev = pos;
+  }
+  head = pos;
+}
+
+void
+RetxTimerWheel::Unlink(size_t pos)
+{
+  Entry& entry = m_entries[pos];
+  if (entry.prev != NONE) {
+    m_entries[entry.prev].next = entry.next;
+  }
+  else {
+    m_slots[entry.tick % m_slots.size()] = entry.next;
+  }
+  if (entry.next != NONE) {
+    m_entries[entry.next].prev = entry.prev;
+  }
+}
+
+void
+RetxTimerWheel::Arm()
+{
+  m_currentTick = Simulator::Now().GetTimeStep() / m_granularity.GetTimeStep();
+  Time next = TimeStep((m_currentTick + 1) * m_granularity.GetTimeStep());
+  m_tickEvent = Simulator::Schedule(next - Simulator::Now(), &RetxTimerWheel::Tick, this);
+}
+
+void
+RetxTimerWheel::Tick()
+{
+  m_currentTick++;
+
+  Time now = Simulator::Now();
+  Time rto = m_getRto();
+
+  // detach entries due at this tick; entries of later rounds stay in the slot
+  std::vector<uint32_t> expired;
+  size_t pos = m_slots[m_currentTick % m_slots.size()];
+  while (pos != NONE) {
+    size_t next = m_entries[pos].next;
+    if (m_entries[pos].tick <= m_currentTick) {
+      Unlink(pos);
+      if (m_entries[pos].sendTime + rto <= now) { // timeout expired?
+        m_free.push_back(pos);
+        m_index.erase(m_entries[pos].seq);
+        expired.push_back(m_entries[pos].seq);
+      }
+      else {
+        // RTO has grown since the entry was inserted
+        Link(pos, m_entries[pos].sendTime + rto);
+      }
+    }
+    pos = next;
+  }
+
+  if (!m_index.empty()) {
+    m_tickEvent = Simulator::Schedule(m_granularity, &RetxTimerWheel::Tick, this);
+  }
+
+  for (uint32_t seq : expired) {
+    NS_LOG_DEBUG("Retransmission timeout for " << seq);
+    m_onTimeout(seq);
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_RETX_TIMER_WHEEL_H
+#define NDN_RETX_TIMER_WHEEL_H
+
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Hashed timing wheel that fires retransmission timeouts of outstanding Interests
+ *
+ * Each outstanding sequence number is placed in the slot of the wheel tick at which its
+ * retransmission timeout (send time + RTO) expires.  Insert and erase are O(1).  The wheel
+ * advances by one slot per granularity period, but only while there are outstanding entries:
+ * a single ns-3 event is armed when the first entry is inserted and is not re-armed once the
+ * wheel becomes empty.
+ *
+ * RTO is evaluated lazily: when a slot is processed, entries are checked against the current
+ * RTO and those that have not expired yet are moved to a later slot.
+ */
+class RetxTimerWheel {
+public:
+  typedef std::function<Time()> RtoCallback;
+  typedef std::function<void(uint32_t)> TimeoutCallback;
+
+  /**
+   * @param getRto     returns current retransmission timeout
+   * @param onTimeout  called with sequence number whose retransmission timeout expired
+   * @param nSlots     number of slots in the wheel
+   */
+  RetxTimerWheel(const RtoCallback& getRto, const TimeoutCallback& onTimeout, size_t nSlots = 512);
+
+  ~RetxTimerWheel();
+
+  /**
+   * @brief Set duration of one wheel slot, i.e., precision of the retransmission timeouts
+   */
+  void
+  SetGranularity(Time granularity);
+
+  Time
+  GetGranularity() const
+  {
+    return m_granularity;
+  }
+
+  /**
+   * @brief Start tracking retransmission timeout of @p seq sent at @p sendTime
+   * @return false, if @p seq is already tracked (the existing entry is left intact)
+   */
+  bool
+  Insert(uint32_t seq, Time sendTime);
+
+  /**
+   * @brief Stop tracking retransmission timeout of @p seq
+   * @return number of erased entries (0 or 1)
+   */
+  size_t
+  Erase(uint32_t seq);
+
+  /**
+   * @brief Stop tracking all entries and disarm the wheel
+   */
+  void
+  Clear();
+
+  size_t
+  size() const
+  {
+    return m_index.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_index.empty();
+  }
+
+private:
+  void
+  Link(size_t pos, Time deadline);
+
+  void
+  Unlink(size_t pos);
+
+  void
+  Arm();
+
+  void
+  Tick();
+
+private:
+  static const size_t NONE;
+
+  struct Entry {
+    uint32_t seq;
+    Time sendTime;
+    int64_t tick;
+    size_t prev;
+    size_t next;
+  };
+
+  RtoCallback m_getRto;
+  TimeoutCallback m_onTimeout;
+  Time m_granularity;
+
+  std::vector<Entry> m_entries;  ///< @brief pool of entries, linked into per-slot lists
+  std::vector<size_t> m_free;    ///< @brief unused positions in m_entries
+  std::vector<size_t> m_slots;   ///< @brief head of the entry list of each slot
+  std::unordered_map<uint32_t, size_t> m_index; ///< @brief seq -> position in m_entries
+
+  int64_t m_currentTick; ///< @brief last processed tick
+  EventId m_tickEvent;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RETX_TIMER_WHEEL_H
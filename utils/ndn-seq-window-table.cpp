@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-seq-window-table.hpp"
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+
+SeqWindowTable::SeqWindowTable(size_t initialCapacity)
+  : m_head(0)
+  , m_base(0)
+  , m_span(0)
+  , m_inUse(0)
+  , m_isSparse(false)
+{
+  size_t capacity = 1;
+  while (capacity < initialCapacity)
+    capacity <<= 1;
+  m_slots.resize(capacity, Entry());
+}
+
+SeqWindowTable::Entry*
+SeqWindowTable::Find(uint32_t seq)
+{
+  if (m_isSparse) {
+    auto entry = m_sparse.find(seq);
+    return entry != m_sparse.end() ? &entry->second : nullptr;
+  }
+
+  if (seq < m_base || seq - m_base >= m_span)
+    return nullptr;
+
+  Entry& entry = At(seq);
+  return (entry.flags & IN_USE) ? &entry : nullptr;
+}
+
+SeqWindowTable::Entry&
+SeqWindowTable::Get(uint32_t seq)
+{
+  if (m_inUse == 0) {
+    // empty window can be moved anywhere
+    m_base = seq;
+    m_span = 0;
+  }
+
+  if (!m_isSparse) {
+    size_t span = seq < m_base ? m_span + (m_base - seq)
+                               : std::max<size_t>(m_span, seq - m_base + 1);
+    if (span > m_slots.size() && span > MAX_SPAN_PER_ENTRY * (m_inUse + 1)) {
+      MakeSparse();
+    }
+  }
+
+  if (m_isSparse) {
+    auto inserted = m_sparse.insert(std::make_pair(seq, Entry()));
+    if (inserted.second) {
+      inserted.first->second.flags = IN_USE;
+      m_inUse++;
+    }
+    return inserted.first->second;
+  }
+
+  if (seq < m_base) {
+    // extend the window backwards
+    size_t extra = m_base - seq;
+    Resize(m_span + extra);
+    m_head = (m_head - extra) & (m_slots.size() - 1);
+    m_base = seq;
+    m_span += extra;
+  }
+  else if (seq - m_base >= m_span) {
+    Resize(seq - m_base + 1);
+    m_span = seq - m_base + 1;
+  }
+
+  Entry& entry = At(seq);
+  if (!(entry.flags & IN_USE)) {
+    entry = Entry();
+    entry.flags = IN_USE;
+    m_inUse++;
+  }
+  return entry;
+}
+
+void
+SeqWindowTable::Release(uint32_t seq)
+{
+  if (m_isSparse) {
+    m_inUse -= m_sparse.erase(seq);
+    if (m_inUse == 0) {
+      m_isSparse = false;
+      m_span = 0;
+    }
+    return;
+  }
+
+  Entry* entry = Find(seq);
+  if (entry == nullptr)
+    return;
+
+  *entry = Entry();
+  m_inUse--;
+
+  if (m_inUse == 0) {
+    m_span = 0;
+    return;
+  }
+
+  while (m_span > 0 && !(m_slots[m_head].flags & IN_USE)) {
+    m_head = (m_head + 1) & (m_slots.size() - 1);
+    m_base++;
+    m_span--;
+  }
+}
+
+void
+SeqWindowTable::Resize(size_t span)
+{
+  if (span <= m_slots.size())
+    return;
+
+  size_t capacity = m_slots.size();
+  while (capacity < span)
+    capacity <<= 1;
+
+  std::vector<Entry> slots(capacity, Entry());
+  for (size_t i = 0; i < m_span; i++) {
+    slots[i] = m_slots[(m_head + i) & (m_slots.size() - 1)];
+  }
+  m_slots.swap(slots);
+  m_head = 0;
+}
+
+void
+SeqWindowTable::MakeSparse()
+{
+  for (size_t i = 0; i < m_span; i++) {
+    Entry& entry = m_slots[(m_head + i) & (m_slots.size() - 1)];
+    if (entry.flags & IN_USE) {
+      m_sparse.insert(std::make_pair(m_base + i, entry));
+      entry = Entry();
+    }
+  }
+  m_isSparse = true;
+  m_head = 0;
+  m_span = 0;
+}
+
+} // namespace ndn
+} // namespace ns3
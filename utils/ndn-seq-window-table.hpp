@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_SEQ_WINDOW_TABLE_H
+#define NDN_SEQ_WINDOW_TABLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Per-sequence-number state of a consumer, kept in one contiguous sliding window
+ *
+ * Entries are addressed by `seq - base` in a ring buffer whose capacity is a power of two.
+ * The window grows (by doubling the buffer) when a sequence number outside of it is used, and
+ * slides forward when entries at its front are released.  Consumers that request sequence
+ * numbers in increasing order therefore keep a small window of recent entries without any
+ * per-entry allocation.
+ *
+ * Consumers that draw sequence numbers at random (e.g., ConsumerZipfMandelbrot) would stretch
+ * the window over the whole catalogue.  When growing the buffer would make the window span more
+ * than MAX_SPAN_PER_ENTRY times the number of entries in use, the table switches to sparse
+ * storage in a map instead, and returns to the window once it becomes empty.
+ */
+class SeqWindowTable {
+public:
+  enum EntryFlags {
+    IN_USE = 1 << 0,    ///< @brief entry holds state of a sequence number
+    PENDING = 1 << 1,   ///< @brief Interest sent, Data not received yet
+    RETX = 1 << 2,      ///< @brief retransmission timeout has expired
+    RECEIVED = 1 << 3,  ///< @brief Data has been received
+  };
+
+  struct Entry {
+    Time firstSent;     ///< @brief time when the first Interest was sent
+    Time lastSent;      ///< @brief time when the last (re)transmitted Interest was sent
+    uint32_t retxCount; ///< @brief number of Interests sent
+    uint8_t flags;      ///< @brief combination of EntryFlags
+
+    shared_ptr<Interest> interest; ///< @brief last transmitted Interest, reused by retransmissions
+  };
+
+  /// @brief sparsest window, in sequence numbers per entry in use, worth growing the buffer for
+  static const size_t MAX_SPAN_PER_ENTRY = 16;
+
+  explicit
+  SeqWindowTable(size_t initialCapacity = 64);
+
+  /**
+   * @brief Get entry of @p seq, or nullptr if @p seq is not in use
+   */
+  Entry*
+  Find(uint32_t seq);
+
+  /**
+   * @brief Get entry of @p seq, creating an empty one if @p seq is not in use
+   */
+  Entry&
+  Get(uint32_t seq);
+
+  /**
+   * @brief Drop state of @p seq and slide the window over released front entries
+   */
+  void
+  Release(uint32_t seq);
+
+  /**
+   * @brief Get the lowest sequence number covered by the window (the lowest one in use, if the
+   *        table is sparse)
+   */
+  uint32_t
+  GetBase() const
+  {
+    return m_isSparse ? m_sparse.begin()->first : m_base;
+  }
+
+  /**
+   * @brief Get number of slots of the ring buffer
+   */
+  size_t
+  GetCapacity() const
+  {
+    return m_slots.size();
+  }
+
+  /**
+   * @brief Check whether entries are kept in a map rather than in the window
+   */
+  bool
+  IsSparse() const
+  {
+    return m_isSparse;
+  }
+
+  /**
+   * @brief Get number of sequence numbers in use
+   */
+  size_t
+  size() const
+  {
+    return m_inUse;
+  }
+
+private:
+  Entry&
+  At(uint32_t seq)
+  {
+    return m_slots[(m_head + (seq - m_base)) & (m_slots.size() - 1)];
+  }
+
+  void
+  Resize(size_t span);
+
+  /**
+   * @brief Move entries in use from the window into the map
+   */
+  void
+  MakeSparse();
+
+private:
+  std::vector<Entry> m_slots; ///< @brief ring buffer, size is a power of two
+  size_t m_head;              ///< @brief position of m_base in m_slots
+  uint32_t m_base;            ///< @brief sequence number of the window front
+  size_t m_span;              ///< @brief number of sequence numbers covered by the window
+  size_t m_inUse;             ///< @brief number of entries in use
+
+  bool m_isSparse;                    ///< @brief entries are in m_sparse instead of m_slots
+  std::map<uint32_t, Entry> m_sparse; ///< @brief entries in use while the table is sparse
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SEQ_WINDOW_TABLE_H
@@ -0,0 +1,218 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef ALLOCATOR_POLICY_H_
+#define ALLOCATOR_POLICY_H_
+
+/// @cond include_hidden
+
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Trie allocator that takes every node, bucket array and other block of memory (such as
+ *        the hashed child sets of trie nodes) straight from the global heap
+ */
+template<class Node, class Bucket>
+class heap_allocator : boost::noncopyable {
+public:
+  void*
+  allocate_node()
+  {
+    return ::operator new(sizeof(Node));
+  }
+
+  void
+  deallocate_node(void* node)
+  {
+    ::operator delete(node);
+  }
+
+  Bucket*
+  allocate_buckets(size_t n)
+  {
+    return new Bucket[n];
+  }
+
+  void
+  deallocate_buckets(Bucket* buckets, size_t n)
+  {
+    delete[] buckets;
+  }
+
+  void*
+  allocate_memory(size_t size)
+  {
+    return ::operator new(size);
+  }
+
+  void
+  deallocate_memory(void* memory, size_t size)
+  {
+    ::operator delete(memory);
+  }
+};
+
+/**
+ * @brief Trie allocator that recycles nodes, bucket arrays and other blocks within one trie
+ *
+ * Nodes are carved out of slabs of NODES_PER_SLAB nodes, while bucket arrays and other blocks
+ * are rounded up to a power of two bytes.  Released nodes and blocks are kept on per-size free
+ * lists and handed out again by later inserts; memory is returned to the heap only when the
+ * allocator (i.e., the trie that owns it) is destroyed.  Once the free lists have been filled,
+ * a store that keeps inserting and evicting at full capacity no longer touches the heap.
+ */
+template<class Node, class Bucket>
+class pool_allocator : boost::noncopyable {
+public:
+  pool_allocator()
+    : free_nodes_(0)
+  {
+  }
+
+  ~pool_allocator()
+  {
+    for (char* slab : slabs_) {
+      ::operator delete(slab);
+    }
+    for (free_block* block : free_blocks_) {
+      while (block != 0) {
+        free_block* next = block->next;
+        ::operator delete(block);
+        block = next;
+      }
+    }
+  }
+
+  void*
+  allocate_node()
+  {
+    if (free_nodes_ == 0) {
+      grow();
+    }
+    free_block* block = free_nodes_;
+    free_nodes_ = block->next;
+    return block;
+  }
+
+  void
+  deallocate_node(void* node)
+  {
+    free_block* block = static_cast<free_block*>(node);
+    block->next = free_nodes_;
+    free_nodes_ = block;
+  }
+
+  Bucket*
+  allocate_buckets(size_t n)
+  {
+    Bucket* buckets = static_cast<Bucket*>(allocate_memory(sizeof(Bucket) * n));
+    for (size_t i = 0; i < n; i++) {
+      new (buckets + i) Bucket();
+    }
+    return buckets;
+  }
+
+  void
+  deallocate_buckets(Bucket* buckets, size_t n)
+  {
+    for (size_t i = 0; i < n; i++) {
+      buckets[i].~Bucket();
+    }
+    deallocate_memory(buckets, sizeof(Bucket) * n);
+  }
+
+  void*
+  allocate_memory(size_t size)
+  {
+    size_t sizeClass = get_size_class(size);
+    if (sizeClass < free_blocks_.size() && free_blocks_[sizeClass] != 0) {
+      free_block* block = free_blocks_[sizeClass];
+      free_blocks_[sizeClass] = block->next;
+      return block;
+    }
+    return ::operator new(static_cast<size_t>(1) << sizeClass);
+  }
+
+  void
+  deallocate_memory(void* memory, size_t size)
+  {
+    size_t sizeClass = get_size_class(size);
+    if (sizeClass >= free_blocks_.size()) {
+      free_blocks_.resize(sizeClass + 1, 0);
+    }
+    free_block* block = static_cast<free_block*>(memory);
+    block->next = free_blocks_[sizeClass];
+    free_blocks_[sizeClass] = block;
+  }
+
+private:
+  struct free_block {
+    free_block* next;
+  };
+
+  /**
+   * @brief Get index of the smallest power of two that can hold @p size bytes
+   */
+  static size_t
+  get_size_class(size_t size)
+  {
+    size = std::max(size, sizeof(free_block));
+    size_t sizeClass = 0;
+    while ((static_cast<size_t>(1) << sizeClass) < size) {
+      sizeClass++;
+    }
+    return sizeClass;
+  }
+
+  void
+  grow()
+  {
+    size_t slotSize = std::max(sizeof(Node), sizeof(free_block));
+    slotSize = (slotSize + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+
+    char* slab = static_cast<char*>(::operator new(slotSize * NODES_PER_SLAB));
+    slabs_.push_back(slab);
+    for (size_t i = NODES_PER_SLAB; i > 0; i--) {
+      deallocate_node(slab + (i - 1) * slotSize);
+    }
+  }
+
+private:
+  static const size_t NODES_PER_SLAB = 64;
+
+  free_block* free_nodes_;
+  std::vector<char*> slabs_;
+  std::vector<free_block*> free_blocks_; ///< @brief free lists of released blocks by size class
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // ALLOCATOR_POLICY_H_
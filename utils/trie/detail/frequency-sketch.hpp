@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef FREQUENCY_SKETCH_H_
+#define FREQUENCY_SKETCH_H_
+
+/// @cond include_hidden
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <stdint.h>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+namespace detail {
+
+/**
+ * @brief Count-min sketch of access frequencies with periodic aging
+ *
+ * Every key is counted in DEPTH rows of saturating counters (at most MAX_COUNT), and its
+ * frequency is estimated as the minimum over the rows.  After the number of recorded accesses
+ * reaches ten times the row width, all counters are halved, so that the sketch follows
+ * changes in popularity instead of remembering the whole history.
+ */
+class frequency_sketch {
+public:
+  static const size_t DEPTH = 4;
+  static const uint8_t MAX_COUNT = 15;
+
+  frequency_sketch()
+    : additions_(0)
+    , sampleSize_(0)
+  {
+    resize(16);
+  }
+
+  /**
+   * @brief Set number of counters per row (rounded up to a power of two) and forget everything
+   */
+  void
+  resize(size_t width)
+  {
+    size_t actual = 16;
+    while (actual < width)
+      actual <<= 1;
+
+    counters_.assign(DEPTH * actual, 0);
+    mask_ = actual - 1;
+    additions_ = 0;
+    sampleSize_ = 10 * actual;
+  }
+
+  void
+  increment(size_t hash)
+  {
+    bool incremented = false;
+    for (size_t row = 0; row < DEPTH; row++) {
+      uint8_t& counter = counters_[index(hash, row)];
+      if (counter < MAX_COUNT) {
+        counter++;
+        incremented = true;
+      }
+    }
+
+    if (incremented && ++additions_ >= sampleSize_)
+      age();
+  }
+
+  uint8_t
+  estimate(size_t hash) const
+  {
+    uint8_t frequency = MAX_COUNT;
+    for (size_t row = 0; row < DEPTH; row++) {
+      frequency = std::min(frequency, counters_[index(hash, row)]);
+    }
+    return frequency;
+  }
+
+  void
+  clear()
+  {
+    std::fill(counters_.begin(), counters_.end(), 0);
+    additions_ = 0;
+  }
+
+private:
+  size_t
+  index(size_t hash, size_t row) const
+  {
+    // double hashing: rows probe with different odd strides derived from the same hash
+    size_t stride = ((hash >> 16) * 0x9e3779b9) | 1;
+    return row * (mask_ + 1) + ((hash + row * stride) & mask_);
+  }
+
+  void
+  age()
+  {
+    for (std::vector<uint8_t>::iterator counter = counters_.begin(); counter != counters_.end();
+         counter++) {
+      *counter >>= 1;
+    }
+    additions_ /= 2;
+  }
+
+private:
+  std::vector<uint8_t> counters_; ///< @brief DEPTH rows of (mask_ + 1) counters
+  size_t mask_;
+  size_t additions_;  ///< @brief accesses recorded since the last aging (halved on aging)
+  size_t sampleSize_; ///< @brief number of accesses that triggers aging
+};
+
+} // detail
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // FREQUENCY_SKETCH_H_
@@ -62,6 +62,7 @@ struct fifo_policy_traits {
       type(Base& base)
         : base_(base)
         , max_size_(100)
+        , max_bytes_(0)
       {
       }
 
@@ -78,6 +79,15 @@ struct fifo_policy_traits {
           base_.erase(&(*policy_container::begin()));
         }
 
+        if (max_bytes_ != 0) {
+          size_t bytes = Base::s_payload_size(item);
+          if (bytes > max_bytes_)
+            return false;
+          while (!policy_container::empty() && base_.get_bytes() + bytes > max_bytes_) {
+            base_.erase(&(*policy_container::begin()));
+          }
+        }
+
         policy_container::push_back(*item);
         return true;
       }
@@ -112,6 +122,18 @@ struct fifo_policy_traits {
         return max_size_;
       }
 
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+
     private:
       type()
         : base_(*((Base*)0)){};
@@ -119,6 +141,7 @@ struct fifo_policy_traits {
     private:
       Base& base_;
       size_t max_size_;
+      size_t max_bytes_;
     };
   };
 };
@@ -0,0 +1,182 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef HASH_INDEX_H_
+#define HASH_INDEX_H_
+
+/// @cond include_hidden
+
+#include <vector>
+#include <cstddef>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Open-addressing table that maps full-name hashes to trie nodes
+ *
+ * Slots are probed linearly and erased with backward shifting, so the table never accumulates
+ * tombstones.  It doubles whenever it becomes half full and keeps its capacity on clear(), so
+ * a cache in steady state does not allocate.  Hash collisions are resolved by the caller-supplied
+ * match predicate, which is only invoked for slots with the same full hash.
+ */
+template<class Node>
+class hash_index {
+public:
+  hash_index()
+    : size_(0)
+  {
+  }
+
+  template<class Match>
+  Node*
+  find(std::size_t hash, Match match) const
+  {
+    if (size_ == 0)
+      return 0;
+
+    for (std::size_t i = home(hash); slots_[i].node_ != 0; i = (i + 1) & mask()) {
+      if (slots_[i].hash_ == hash && match(slots_[i].node_))
+        return slots_[i].node_;
+    }
+    return 0;
+  }
+
+  void
+  insert(std::size_t hash, Node* node)
+  {
+    if (2 * (size_ + 1) > slots_.size())
+      grow();
+
+    place(hash, node);
+    size_++;
+  }
+
+  void
+  erase(std::size_t hash, Node* node)
+  {
+    if (size_ == 0)
+      return;
+
+    std::size_t hole = home(hash);
+    while (slots_[hole].node_ != node) {
+      if (slots_[hole].node_ == 0)
+        return; // not indexed
+      hole = (hole + 1) & mask();
+    }
+
+    // pull back every following entry of the cluster that would not be reachable across the hole
+    for (std::size_t i = (hole + 1) & mask(); slots_[i].node_ != 0; i = (i + 1) & mask()) {
+      std::size_t distance = (i - home(slots_[i].hash_)) & mask();
+      if (distance >= ((i - hole) & mask())) {
+        slots_[hole] = slots_[i];
+        hole = i;
+      }
+    }
+    slots_[hole] = slot();
+    size_--;
+  }
+
+  void
+  clear()
+  {
+    slots_.assign(slots_.size(), slot());
+    size_ = 0;
+  }
+
+  /**
+   * @brief Clear the index and release its memory
+   */
+  void
+  reset()
+  {
+    std::vector<slot>().swap(slots_);
+    size_ = 0;
+  }
+
+  std::size_t
+  size() const
+  {
+    return size_;
+  }
+
+private:
+  struct slot {
+    slot()
+      : hash_(0)
+      , node_(0)
+    {
+    }
+
+    std::size_t hash_;
+    Node* node_;
+  };
+
+  std::size_t
+  mask() const
+  {
+    return slots_.size() - 1;
+  }
+
+  std::size_t
+  home(std::size_t hash) const
+  {
+    // full-name hashes are combined component hashes, spread their high bits over the mask
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3b;
+    hash ^= hash >> 16;
+    return hash & mask();
+  }
+
+  void
+  place(std::size_t hash, Node* node)
+  {
+    std::size_t i = home(hash);
+    while (slots_[i].node_ != 0)
+      i = (i + 1) & mask();
+
+    slots_[i].hash_ = hash;
+    slots_[i].node_ = node;
+  }
+
+  void
+  grow()
+  {
+    std::vector<slot> old(slots_.empty() ? 16 : 2 * slots_.size());
+    old.swap(slots_);
+
+    for (typename std::vector<slot>::const_iterator item = old.begin(); item != old.end(); item++) {
+      if (item->node_ != 0)
+        place(item->hash_, item->node_);
+    }
+  }
+
+private:
+  std::vector<slot> slots_; ///< @brief power-of-two number of slots
+  std::size_t size_;        ///< @brief number of indexed nodes
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // HASH_INDEX_H_
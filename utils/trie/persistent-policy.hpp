@@ -65,6 +65,7 @@ struct persistent_policy_traits {
       type(Base& base)
         : base_(base)
         , max_size_(100) // when 0, policy is not enforced
+        , max_bytes_(0)
       {
       }
 
@@ -80,6 +81,9 @@ struct persistent_policy_traits {
         if (max_size_ != 0 && policy_container::size() >= max_size_)
           return false;
 
+        if (max_bytes_ != 0 && base_.get_bytes() + Base::s_payload_size(item) > max_bytes_)
+          return false;
+
         policy_container::push_back(*item);
         return true;
       }
@@ -114,12 +118,25 @@ struct persistent_policy_traits {
         return max_size_;
       }
 
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+
     private:
       // type () : base_(*((Base*)0)) { };
 
     private:
       Base& base_;
       size_t max_size_;
+      size_t max_bytes_;
     };
   };
 };
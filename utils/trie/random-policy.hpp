@@ -92,6 +92,7 @@ struct random_policy_traits {
         : base_(base)
         , u_rand(CreateObject<UniformRandomVariable>())
         , max_size_(100)
+        , max_bytes_(0)
       {
         u_rand->SetAttribute("Min", DoubleValue(0));
         u_rand->SetAttribute("Max", DoubleValue(std::numeric_limits<uint32_t>::max()));
@@ -120,6 +121,17 @@ struct random_policy_traits {
           }
         }
 
+        if (max_bytes_ != 0) {
+          size_t bytes = Base::s_payload_size(item);
+          if (bytes > max_bytes_)
+            return false;
+          while (!policy_container::empty() && base_.get_bytes() + bytes > max_bytes_) {
+            if (MemberHookLess<Container>()(*item, *policy_container::begin()))
+              return false; // the new item would be the next one to go
+            base_.erase(&(*policy_container::begin()));
+          }
+        }
+
         policy_container::insert(*item);
         return true;
       }
@@ -154,6 +166,18 @@ struct random_policy_traits {
         return max_size_;
       }
 
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+
     private:
       type()
         : base_(*((Base*)0)){};
@@ -162,6 +186,7 @@ struct random_policy_traits {
       Base& base_;
       Ptr<UniformRandomVariable> u_rand;
       size_t max_size_;
+      size_t max_bytes_;
     };
   };
 };
@@ -23,33 +23,46 @@
 /// @cond include_hidden
 
 #include "trie.hpp"
+#include "hash-index.hpp"
 
 namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
 
-template<typename FullKey, typename PayloadTraits, typename PolicyTraits>
+template<typename FullKey, typename PayloadTraits, typename PolicyTraits,
+         template<class Node, class Bucket> class Allocator = pool_allocator>
 class trie_with_policy {
 public:
-  typedef trie<FullKey, PayloadTraits, typename PolicyTraits::policy_hook_type> parent_trie;
+  typedef trie<FullKey, PayloadTraits, typename PolicyTraits::policy_hook_type, Allocator>
+    parent_trie;
 
   typedef typename parent_trie::iterator iterator;
   typedef typename parent_trie::const_iterator const_iterator;
 
   typedef typename PolicyTraits::
-    template policy<trie_with_policy<FullKey, PayloadTraits, PolicyTraits>, parent_trie,
+    template policy<trie_with_policy<FullKey, PayloadTraits, PolicyTraits, Allocator>, parent_trie,
                     typename PolicyTraits::template container_hook<parent_trie>::type>::type
       policy_container;
 
-  inline trie_with_policy(size_t bucketSize = 1, size_t bucketIncrement = 1)
-    : trie_(name::Component(), bucketSize, bucketIncrement)
+  inline trie_with_policy()
+    : trie_(name::Component(), allocator_)
     , policy_(*this)
+    , useIndex_(true)
+    , bytes_(0)
   {
   }
 
   inline std::pair<iterator, bool>
   insert(const FullKey& key, typename PayloadTraits::insert_type payload)
   {
+    std::size_t hash = 0;
+    if (useIndex_) {
+      hash = s_key_hash(key);
+      iterator existing = find_indexed(key, hash);
+      if (existing != end())
+        return std::make_pair(existing, false);
+    }
+
     std::pair<iterator, bool> item = trie_.insert(key, payload);
 
     if (item.second) // real insert
@@ -59,6 +72,9 @@ public:
         item.first->erase(); // cannot insert
         return std::make_pair(end(), false);
       }
+      if (useIndex_)
+        index_.insert(hash, item.first);
+      bytes_ += s_payload_size(item.first);
     }
     else {
       return std::make_pair(s_iterator_to(item.first), false);
@@ -70,6 +86,11 @@ public:
   inline void
   erase(const FullKey& key)
   {
+    if (useIndex_) {
+      erase(find_indexed(key, s_key_hash(key)));
+      return;
+    }
+
     iterator foundItem, lastItem;
     bool reachLast;
     std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
@@ -86,6 +107,9 @@ public:
     if (node == end())
       return;
 
+    if (useIndex_)
+      index_.erase(s_node_hash(node), node);
+    bytes_ -= s_payload_size(node);
     policy_.erase(s_iterator_to(node));
     node->erase(); // will do cleanup here
   }
@@ -94,7 +118,62 @@ public:
   clear()
   {
     policy_.clear();
+    index_.clear();
     trie_.clear();
+    bytes_ = 0;
+  }
+
+  /**
+   * @brief Get total size of all payloads in the trie, in bytes
+   *
+   * Policies compare this value against their byte budget (set_max_bytes) on every insert.
+   */
+  size_t
+  get_bytes() const
+  {
+    return bytes_;
+  }
+
+  /**
+   * @brief Get size of the item's payload in bytes
+   *
+   * The payload is expected to report its own size with GetSize(), as cs::Entry does.
+   */
+  static size_t
+  s_payload_size(const_iterator item)
+  {
+    return item->payload()->GetSize();
+  }
+
+  /**
+   * @brief Enable or disable the full-name hash index
+   *
+   * With the index enabled (default), exact lookups, erasures and duplicate checks on insert
+   * take a single probe instead of a walk from the root.  Enabling the index on a non-empty
+   * trie rebuilds it from the existing entries.
+   */
+  void
+  set_hash_index(bool enable)
+  {
+    if (enable == useIndex_)
+      return;
+
+    useIndex_ = enable;
+    index_.reset();
+    if (!useIndex_)
+      return;
+
+    typename parent_trie::recursive_iterator item(trie_), end(0);
+    for (; item != end; item++) {
+      if (item->payload() != PayloadTraits::empty_payload)
+        index_.insert(s_node_hash(&(*item)), &(*item));
+    }
+  }
+
+  bool
+  get_hash_index() const
+  {
+    return useIndex_;
   }
 
   template<typename Modifier>
@@ -117,6 +196,9 @@ public:
   inline iterator
   find_exact(const FullKey& key)
   {
+    if (useIndex_)
+      return find_indexed(key, s_key_hash(key));
+
     iterator foundItem, lastItem;
     bool reachLast;
     std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
@@ -133,6 +215,15 @@ public:
   inline iterator
   longest_prefix_match(const FullKey& key)
   {
+    if (useIndex_) {
+      // an entry for the whole key is always the longest prefix match
+      iterator exact = find_indexed(key, s_key_hash(key));
+      if (exact != end()) {
+        policy_.lookup(exact);
+        return exact;
+      }
+    }
+
     iterator foundItem, lastItem;
     bool reachLast;
     std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
@@ -174,6 +265,14 @@ public:
   inline iterator
   deepest_prefix_match(const FullKey& key)
   {
+    if (useIndex_) {
+      iterator exact = find_indexed(key, s_key_hash(key));
+      if (exact != end()) {
+        policy_.lookup(exact);
+        return exact;
+      }
+    }
+
     iterator foundItem, lastItem;
     bool reachLast;
     std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
@@ -292,9 +391,83 @@ public:
       return &(*item);
   }
 
+  /**
+   * @brief Compute the full-name hash of the node from the components on its path
+   */
+  static std::size_t
+  s_node_hash(const_iterator node)
+  {
+    if (node->parent() == 0)
+      return 0;
+
+    std::size_t hash = s_node_hash(node->parent());
+    s_hash_combine(hash, node->key());
+    return hash;
+  }
+
 private:
+  typedef typename FullKey::value_type Key;
+
+  static void
+  s_hash_combine(std::size_t& hash, const Key& component)
+  {
+    hash ^= boost::hash_value(component) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+
+  static std::size_t
+  s_key_hash(const FullKey& key)
+  {
+    std::size_t hash = 0;
+    BOOST_FOREACH (const Key& component, key) {
+      s_hash_combine(hash, component);
+    }
+    return hash;
+  }
+
+  /**
+   * @brief Check that the path from the root to the node spells exactly the key
+   */
+  static bool
+  s_node_matches(const_iterator node, const FullKey& key)
+  {
+    for (size_t i = key.size(); i > 0; i--) {
+      if (node->parent() == 0 || !(node->key() == key[i - 1]))
+        return false;
+      node = node->parent();
+    }
+    return node->parent() == 0;
+  }
+
+  struct node_matches {
+    node_matches(const FullKey& key)
+      : key_(key)
+    {
+    }
+
+    bool
+    operator()(const_iterator node) const
+    {
+      return s_node_matches(node, key_);
+    }
+
+    const FullKey& key_;
+  };
+
+  iterator
+  find_indexed(const FullKey& key, std::size_t hash) const
+  {
+    return index_.find(hash, node_matches(key));
+  }
+
+private:
+  typename parent_trie::allocator_type allocator_; ///< @brief must outlive trie_
   parent_trie trie_;
   mutable policy_container policy_;
+
+  hash_index<parent_trie> index_; ///< @brief full-name hash to payload node
+  bool useIndex_;
+
+  size_t bytes_; ///< @brief accumulated size of all payloads
 };
 
 } // ndnSIM
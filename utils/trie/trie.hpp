@@ -24,13 +24,15 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "allocator-policy.hpp"
+
 #include "ns3/ptr.h"
 
 #include <boost/intrusive/unordered_set.hpp>
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
 #include <boost/functional/hash.hpp>
-#include <boost/interprocess/smart_ptr/unique_ptr.hpp>
+#include <memory>
 #include <tuple>
 #include <boost/foreach.hpp>
 #include <boost/mpl/if.hpp>
@@ -101,21 +103,25 @@ Payload non_pointer_traits<Payload, BasePayload>::empty_payload = Payload();
 ////////////////////////////////////////////////////
 // forward declarations
 //
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook,
+         template<class Node, class Bucket> class Allocator = pool_allocator>
 class trie;
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook,
+         template<class, class> class Allocator>
 inline std::ostream&
-operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
+operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& trie_node);
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook,
+         template<class, class> class Allocator>
 bool
-operator==(const trie<FullKey, PayloadTraits, PolicyHook>& a,
-           const trie<FullKey, PayloadTraits, PolicyHook>& b);
+operator==(const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& a,
+           const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& b);
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook,
+         template<class, class> class Allocator>
 std::size_t
-hash_value(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
+hash_value(const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& trie_node);
 
 ///////////////////////////////////////////////////
 // actual definition
@@ -126,8 +132,35 @@ class trie_iterator;
 template<class T>
 class trie_point_iterator;
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+/**
+ * @brief Name trie, each node of which is a trie itself
+ *
+ * Children of a node are kept inline, in an array of up to INLINE_CHILDREN pointers with the
+ * hashes of their name components next to it, and are found by a linear scan over these
+ * hashes.  Most nodes of name tries have no or very few children (e.g., sequence-numbered
+ * names form long, thin chains), so they need no separate container.  When a node gets more
+ * children, they are moved into a hashed set of their own, which the node keeps until it is
+ * destroyed.
+ *
+ * All nodes of a trie, and the hashed sets with their bucket arrays, are obtained from one
+ * Allocator<trie, bucket_type> object, which is supplied to the root and must outlive the
+ * trie (see heap_allocator and pool_allocator).
+ */
+template<typename FullKey, typename PayloadTraits, typename PolicyHook,
+         template<class Node, class Bucket> class Allocator>
 class trie {
+private:
+  boost::intrusive::unordered_set_member_hook<> unordered_set_member_hook_;
+
+  // necessary typedefs
+  typedef trie self_type;
+  typedef boost::intrusive::member_hook<trie, boost::intrusive::unordered_set_member_hook<>,
+                                        &trie::unordered_set_member_hook_> member_hook;
+
+  typedef boost::intrusive::unordered_set<trie, member_hook> unordered_set;
+  typedef typename unordered_set::bucket_type bucket_type;
+  typedef typename unordered_set::bucket_traits bucket_traits;
+
 public:
   typedef typename FullKey::value_type Key;
 
@@ -142,30 +175,43 @@ public:
 
   typedef PayloadTraits payload_traits;
 
-  inline trie(const Key& key, size_t bucketSize = 1, size_t bucketIncrement = 1)
+  typedef Allocator<trie, bucket_type> allocator_type;
+
+  /// @brief Maximum number of children stored inline, without a hashed set
+  static const size_t INLINE_CHILDREN = 4;
+
+  inline trie(const Key& key, allocator_type& allocator)
     : key_(key)
-    , initialBucketSize_(bucketSize)
-    , bucketIncrement_(bucketIncrement)
-    , bucketSize_(initialBucketSize_)
-    , buckets_(new bucket_type[bucketSize_]) // cannot use normal pointer, because lifetime of
-                                             // buckets should be larger than lifetime of the
-                                             // container
-    , children_(bucket_traits(buckets_.get(), bucketSize_))
+    , allocator_(&allocator)
     , payload_(PayloadTraits::empty_payload)
     , parent_(nullptr)
+    , nChildren_(0)
+    , isHashed_(false)
   {
   }
 
   inline ~trie()
   {
     payload_ = PayloadTraits::empty_payload; // necessary for smart pointers...
-    children_.clear_and_dispose(trie_delete_disposer());
+    clear();
   }
 
   void
   clear()
   {
-    children_.clear_and_dispose(trie_delete_disposer());
+    if (isHashed_) {
+      child_set* set = children_.set_;
+      set->children_.clear_and_dispose(trie_delete_disposer());
+      set->~child_set();
+      allocator_->deallocate_memory(set, sizeof(child_set));
+      isHashed_ = false;
+    }
+    else {
+      for (size_t i = 0; i < nChildren_; i++) {
+        trie_delete_disposer()(children_.inline_[i]);
+      }
+    }
+    nChildren_ = 0;
   }
 
   template<class Predicate>
@@ -184,11 +230,10 @@ public:
   }
 
   // actual entry
-  friend bool operator==<>(const trie<FullKey, PayloadTraits, PolicyHook>& a,
-                           const trie<FullKey, PayloadTraits, PolicyHook>& b);
+  friend bool operator==<>(const trie& a, const trie& b);
 
   friend std::size_t
-  hash_value<>(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
+  hash_value<>(const trie& trie_node);
 
   inline std::pair<iterator, bool>
   insert(const FullKey& key, typename PayloadTraits::insert_type payload)
@@ -196,28 +241,13 @@ public:
     trie* trieNode = this;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
-      if (item == trieNode->children_.end()) {
-        trie* newNode = new trie(subkey, initialBucketSize_, bucketIncrement_);
-        // std::cout << "new " << newNode << "\n";
-        newNode->parent_ = trieNode;
-
-        if (trieNode->children_.size() >= trieNode->bucketSize_) {
-          trieNode->bucketSize_ += trieNode->bucketIncrement_;
-          trieNode->bucketIncrement_ *= 2; // increase bucketIncrement exponentially
-
-          buckets_array newBuckets(new bucket_type[trieNode->bucketSize_]);
-          trieNode->children_.rehash(bucket_traits(newBuckets.get(), trieNode->bucketSize_));
-          trieNode->buckets_.swap(newBuckets);
-        }
-
-        std::pair<typename unordered_set::iterator, bool> ret =
-          trieNode->children_.insert(*newNode);
-
-        trieNode = &(*ret.first);
+      std::size_t hash = boost::hash_value(subkey);
+      trie* child = trieNode->find_child(subkey, hash);
+      if (child == 0) {
+        child = new (allocator_->allocate_node()) trie(subkey, *allocator_);
+        trieNode->add_child(child, hash);
       }
-      else
-        trieNode = &(*item);
+      trieNode = child;
     }
 
     if (trieNode->payload_ == PayloadTraits::empty_payload) {
@@ -244,14 +274,13 @@ public:
   inline iterator
   prune()
   {
-    if (payload_ == PayloadTraits::empty_payload && children_.size() == 0) {
+    if (payload_ == PayloadTraits::empty_payload && nChildren_ == 0) {
       if (parent_ == 0)
         return this;
 
       trie* parent = parent_;
-      parent->children_
-        .erase_and_dispose(*this,
-                           trie_delete_disposer()); // delete this; basically, committing a suicide
+      parent->remove_child(this);
+      trie_delete_disposer()(this); // delete this; basically, committing a suicide
 
       return parent->prune();
     }
@@ -264,14 +293,12 @@ public:
   inline void
   prune_node()
   {
-    if (payload_ == PayloadTraits::empty_payload && children_.size() == 0) {
+    if (payload_ == PayloadTraits::empty_payload && nChildren_ == 0) {
       if (parent_ == 0)
         return;
 
-      trie* parent = parent_;
-      parent->children_
-        .erase_and_dispose(*this,
-                           trie_delete_disposer()); // delete this; basically, committing a suicide
+      parent_->remove_child(this);
+      trie_delete_disposer()(this); // delete this; basically, committing a suicide
     }
   }
 
@@ -295,13 +322,13 @@ public:
     bool reachLast = true;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
-      if (item == trieNode->children_.end()) {
+      trie* child = trieNode->find_child(subkey, boost::hash_value(subkey));
+      if (child == 0) {
         reachLast = false;
         break;
       }
       else {
-        trieNode = &(*item);
+        trieNode = child;
 
         if (trieNode->payload_ != PayloadTraits::empty_payload)
           foundNode = trieNode;
@@ -326,13 +353,13 @@ public:
     bool reachLast = true;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
-      if (item == trieNode->children_.end()) {
+      trie* child = trieNode->find_child(subkey, boost::hash_value(subkey));
+      if (child == 0) {
         reachLast = false;
         break;
       }
       else {
-        trieNode = &(*item);
+        trieNode = child;
 
         if (trieNode->payload_ != PayloadTraits::empty_payload && pred(trieNode->payload_)) {
           foundNode = trieNode;
@@ -354,11 +381,7 @@ public:
     if (payload_ != PayloadTraits::empty_payload)
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin();
-         subnode != children_.end(); subnode++)
-    // BOOST_FOREACH (trie &subnode, children_)
-    {
+    for (trie* subnode = first_child(); subnode != 0; subnode = next_child(subnode)) {
       iterator value = subnode->find();
       if (value != 0)
         return value;
@@ -380,11 +403,7 @@ public:
     if (payload_ != PayloadTraits::empty_payload && pred(payload_))
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin();
-         subnode != children_.end(); subnode++)
-    // BOOST_FOREACH (const trie &subnode, children_)
-    {
+    for (trie* subnode = first_child(); subnode != 0; subnode = next_child(subnode)) {
       iterator value = subnode->find_if(pred);
       if (value != 0)
         return value;
@@ -406,9 +425,7 @@ public:
   inline const iterator
   find_if_next_level(Predicate pred)
   {
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin();
-         subnode != children_.end(); subnode++) {
+    for (trie* subnode = first_child(); subnode != 0; subnode = next_child(subnode)) {
       if (pred(subnode->key())) {
         return subnode->find();
       }
@@ -447,12 +464,21 @@ public:
     payload_ = payload;
   }
 
-  Key
+  const Key&
   key() const
   {
     return key_;
   }
 
+  /**
+   * @brief Get parent of the node (0 for the root)
+   */
+  const trie*
+  parent() const
+  {
+    return parent_;
+  }
+
   inline void
   PrintStat(std::ostream& os) const;
 
@@ -462,36 +488,187 @@ private:
     void
     operator()(trie* delete_this)
     {
-      delete delete_this;
+      allocator_type* allocator = delete_this->allocator_;
+      delete_this->~trie();
+      allocator->deallocate_node(delete_this);
     }
   };
 
-  template<class D>
-  struct array_disposer {
+  // lookup of children by name component, without constructing a trie node to compare with
+  struct key_hash {
+    std::size_t
+    operator()(const Key& key) const
+    {
+      return boost::hash_value(key);
+    }
+  };
+
+  struct key_equal {
+    bool
+    operator()(const Key& key, const trie& node) const
+    {
+      return key == node.key_;
+    }
+
+    bool
+    operator()(const trie& node, const Key& key) const
+    {
+      return key == node.key_;
+    }
+  };
+
+  struct bucket_disposer {
+    bucket_disposer(allocator_type* allocator, size_t size)
+      : allocator_(allocator)
+      , size_(size)
+    {
+    }
+
     void
-    operator()(D* array)
+    operator()(bucket_type* buckets)
+    {
+      allocator_->deallocate_buckets(buckets, size_);
+    }
+
+    allocator_type* allocator_;
+    size_t size_; ///< @brief number of buckets in the array
+  };
+
+  typedef std::unique_ptr<bucket_type, bucket_disposer> buckets_array;
+
+  /**
+   * @brief Hashed set of children of a node with more than INLINE_CHILDREN children
+   */
+  struct child_set {
+    child_set(allocator_type* allocator, size_t nBuckets)
+      : buckets_(allocator->allocate_buckets(nBuckets), bucket_disposer(allocator, nBuckets))
+      , children_(bucket_traits(buckets_.get(), nBuckets))
     {
-      delete[] array;
     }
+
+    buckets_array buckets_; // must outlive children_
+    unordered_set children_;
   };
 
+  static uint32_t
+  short_hash(std::size_t hash)
+  {
+    return static_cast<uint32_t>(hash);
+  }
+
+  trie*
+  find_child(const Key& key, std::size_t hash) const
+  {
+    if (isHashed_) {
+      typename unordered_set::iterator item =
+        children_.set_->children_.find(key, key_hash(), key_equal());
+      return item == children_.set_->children_.end() ? 0 : &(*item);
+    }
+
+    uint32_t shortHash = short_hash(hash);
+    for (size_t i = 0; i < nChildren_; i++) {
+      if (hashes_[i] == shortHash && children_.inline_[i]->key_ == key) {
+        return children_.inline_[i];
+      }
+    }
+    return 0;
+  }
+
+  void
+  add_child(trie* child, std::size_t hash)
+  {
+    child->parent_ = this;
+
+    if (!isHashed_ && nChildren_ < INLINE_CHILDREN) {
+      children_.inline_[nChildren_] = child;
+      hashes_[nChildren_] = short_hash(hash);
+      nChildren_++;
+      return;
+    }
+
+    if (!isHashed_) {
+      // move the inline children into a hashed set
+      child_set* set = new (allocator_->allocate_memory(sizeof(child_set)))
+        child_set(allocator_, 2 * INLINE_CHILDREN);
+      for (size_t i = 0; i < nChildren_; i++) {
+        set->children_.insert(*children_.inline_[i]);
+      }
+      children_.set_ = set;
+      isHashed_ = true;
+    }
+
+    unordered_set& children = children_.set_->children_;
+    if (children.size() >= children.bucket_count()) {
+      size_t nBuckets = 2 * children.bucket_count();
+      buckets_array newBuckets(allocator_->allocate_buckets(nBuckets),
+                               bucket_disposer(allocator_, nBuckets));
+      children.rehash(bucket_traits(newBuckets.get(), nBuckets));
+      children_.set_->buckets_.swap(newBuckets);
+    }
+    children.insert(*child);
+    nChildren_++;
+  }
+
+  void
+  remove_child(trie* child)
+  {
+    nChildren_--;
+
+    if (isHashed_) {
+      children_.set_->children_.erase(children_.set_->children_.iterator_to(*child));
+      return;
+    }
+
+    size_t i = 0;
+    while (children_.inline_[i] != child) {
+      i++;
+    }
+    // keep the order, so siblings are not skipped by iterators
+    for (; i < nChildren_; i++) {
+      children_.inline_[i] = children_.inline_[i + 1];
+      hashes_[i] = hashes_[i + 1];
+    }
+  }
+
+  trie*
+  first_child() const
+  {
+    if (nChildren_ == 0) {
+      return 0;
+    }
+    if (isHashed_) {
+      return &(*children_.set_->children_.begin());
+    }
+    return children_.inline_[0];
+  }
+
+  /**
+   * @brief Get sibling that follows @p child, or 0 if it is the last child
+   */
+  trie*
+  next_child(const trie* child) const
+  {
+    if (isHashed_) {
+      typename unordered_set::iterator item =
+        children_.set_->children_.iterator_to(const_cast<trie&>(*child));
+      item++;
+      return item == children_.set_->children_.end() ? 0 : &(*item);
+    }
+
+    for (size_t i = 0; i + 1 < nChildren_; i++) {
+      if (children_.inline_[i] == child) {
+        return children_.inline_[i + 1];
+      }
+    }
+    return 0;
+  }
+
   friend std::ostream& operator<<<>(std::ostream& os, const trie& trie_node);
 
 public:
   PolicyHook policy_hook_;
 
 private:
-  boost::intrusive::unordered_set_member_hook<> unordered_set_member_hook_;
-
-  // necessary typedefs
-  typedef trie self_type;
-  typedef boost::intrusive::member_hook<trie, boost::intrusive::unordered_set_member_hook<>,
-                                        &trie::unordered_set_member_hook_> member_hook;
-
-  typedef boost::intrusive::unordered_set<trie, member_hook> unordered_set;
-  typedef typename unordered_set::bucket_type bucket_type;
-  typedef typename unordered_set::bucket_traits bucket_traits;
-
   template<class T, class NonConstT>
   friend class trie_iterator;
 
@@ -503,42 +680,46 @@ private:
   ////////////////////////////////////////////////
 
   Key key_; ///< name component
-
-  size_t initialBucketSize_;
-  size_t bucketIncrement_;
-
-  size_t bucketSize_;
-  typedef boost::interprocess::unique_ptr<bucket_type, array_disposer<bucket_type>> buckets_array;
-  buckets_array buckets_;
-  unordered_set children_;
+  allocator_type* allocator_; ///< allocator of the whole trie
 
   typename PayloadTraits::storage_type payload_;
   trie* parent_; // to make cleaning effective
+
+  uint32_t nChildren_;
+  bool isHashed_; ///< whether children are in children_.set_ rather than inline
+  uint32_t hashes_[INLINE_CHILDREN]; ///< short hashes of the inline children's keys
+  union {
+    trie* inline_[INLINE_CHILDREN];
+    child_set* set_;
+  } children_;
 };
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook,
+         template<class, class> class Allocator>
+const size_t trie<FullKey, PayloadTraits, PolicyHook, Allocator>::INLINE_CHILDREN;
+
+template<typename FullKey, typename PayloadTraits, typename PolicyHook,
+         template<class, class> class Allocator>
 inline std::ostream&
-operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook>& trie_node)
+operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& trie_node)
 {
   os << "# " << trie_node.key_ << ((trie_node.payload_ != PayloadTraits::empty_payload) ? "*" : "")
      << std::endl;
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+  typedef trie<FullKey, PayloadTraits, PolicyHook, Allocator> trie;
 
-  for (typename trie::unordered_set::const_iterator subnode = trie_node.children_.begin();
-       subnode != trie_node.children_.end(); subnode++)
-  // BOOST_FOREACH (const trie &subnode, trie_node.children_)
-  {
+  for (const trie* subnode = trie_node.first_child(); subnode != 0;
+       subnode = trie_node.next_child(subnode)) {
     os << "\"" << &trie_node << "\""
        << " [label=\"" << trie_node.key_
        << ((trie_node.payload_ != PayloadTraits::empty_payload) ? "*" : "") << "\"]\n";
-    os << "\"" << &(*subnode) << "\""
+    os << "\"" << subnode << "\""
        << " [label=\"" << subnode->key_
        << ((subnode->payload_ != PayloadTraits::empty_payload) ? "*" : "") << "\"]"
                                                                               "\n";
 
     os << "\"" << &trie_node << "\""
        << " -> "
-       << "\"" << &(*subnode) << "\""
+       << "\"" << subnode << "\""
        << "\n";
     os << *subnode;
   }
@@ -546,37 +727,42 @@ operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook>& tri
   return os;
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook,
+         template<class, class> class Allocator>
 inline void
-trie<FullKey, PayloadTraits, PolicyHook>::PrintStat(std::ostream& os) const
+trie<FullKey, PayloadTraits, PolicyHook, Allocator>::PrintStat(std::ostream& os) const
 {
   os << "# " << key_ << ((payload_ != PayloadTraits::empty_payload) ? "*" : "") << ": "
-     << children_.size() << " children" << std::endl;
-  for (size_t bucket = 0, maxbucket = children_.bucket_count(); bucket < maxbucket; bucket++) {
-    os << " " << children_.bucket_size(bucket);
+     << nChildren_ << " children" << std::endl;
+  if (isHashed_) {
+    const unordered_set& children = children_.set_->children_;
+    for (size_t bucket = 0, maxbucket = children.bucket_count(); bucket < maxbucket; bucket++) {
+      os << " " << children.bucket_size(bucket);
+    }
+  }
+  else {
+    os << " inline";
   }
   os << "\n";
 
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-  for (typename trie::unordered_set::const_iterator subnode = children_.begin();
-       subnode != children_.end(); subnode++)
-  // BOOST_FOREACH (const trie &subnode, children_)
-  {
+  for (const trie* subnode = first_child(); subnode != 0; subnode = next_child(subnode)) {
     subnode->PrintStat(os);
   }
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook,
+         template<class, class> class Allocator>
 inline bool
-operator==(const trie<FullKey, PayloadTraits, PolicyHook>& a,
-           const trie<FullKey, PayloadTraits, PolicyHook>& b)
+operator==(const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& a,
+           const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& b)
 {
   return a.key_ == b.key_;
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook,
+         template<class, class> class Allocator>
 inline std::size_t
-hash_value(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node)
+hash_value(const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& trie_node)
 {
   return boost::hash_value(trie_node.key_);
 }
@@ -637,8 +823,8 @@ public:
   trie_iterator<Trie, NonConstTrie>&
   operator++(int)
   {
-    if (trie_->children_.size() > 0)
-      trie_ = &(*trie_->children_.begin());
+    if (trie_->nChildren_ > 0)
+      trie_ = trie_->first_child();
     else
       trie_ = goUp();
     return *this;
@@ -652,20 +838,13 @@ public:
   }
 
 private:
-  typedef typename boost::mpl::if_<boost::is_same<Trie, NonConstTrie>,
-                                   typename Trie::unordered_set::iterator,
-                                   typename Trie::unordered_set::const_iterator>::type set_iterator;
-
   Trie*
   goUp()
   {
     if (trie_->parent_ != 0) {
-      // typename Trie::unordered_set::iterator item =
-      set_iterator item = const_cast<NonConstTrie*>(trie_)
-                            ->parent_->children_.iterator_to(const_cast<NonConstTrie&>(*trie_));
-      item++;
-      if (item != trie_->parent_->children_.end()) {
-        return &(*item);
+      Trie* next = trie_->parent_->next_child(trie_);
+      if (next != 0) {
+        return next;
       }
       else {
         trie_ = trie_->parent_;
@@ -682,11 +861,6 @@ private:
 
 template<class Trie>
 class trie_point_iterator {
-private:
-  typedef typename boost::mpl::if_<boost::is_same<Trie, const Trie>,
-                                   typename Trie::unordered_set::const_iterator,
-                                   typename Trie::unordered_set::iterator>::type set_iterator;
-
 public:
   trie_point_iterator()
     : trie_(0)
@@ -697,11 +871,8 @@ public:
   {
   }
   trie_point_iterator(Trie& item)
+    : trie_(item.first_child())
   {
-    if (item.children_.size() != 0)
-      trie_ = &*item.children_.begin();
-    else
-      trie_ = 0;
   }
 
   Trie& operator*()
@@ -745,12 +916,7 @@ public:
   operator++(int)
   {
     if (trie_->parent_ != 0) {
-      set_iterator item = trie_->parent_->children_.iterator_to(*trie_);
-      item++;
-      if (item == trie_->parent_->children_.end())
-        trie_ = 0;
-      else
-        trie_ = &*item;
+      trie_ = trie_->parent_->next_child(trie_);
     }
     else {
       trie_ = 0;
@@ -0,0 +1,377 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef WTINYLFU_POLICY_H_
+#define WTINYLFU_POLICY_H_
+
+/// @cond include_hidden
+
+#include "detail/frequency-sketch.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for Window TinyLFU replacement policy
+ *
+ * New entries enter a small LRU admission window (1% of the capacity).  An entry that falls out
+ * of the window is admitted into the main region only if it has been requested more often than
+ * the entry the main region would evict for it.  Request frequencies are estimated with a
+ * count-min sketch that is periodically aged.  The main region is a segmented LRU: entries
+ * start in the probationary segment and move to the protected segment (80% of the main
+ * region) on their first hit, so a scan of one-time requests cannot flush popular entries.
+ *
+ * All three segments are kept in one intrusive list, ordered as probation, protected and
+ * window, each from least to most recently used.  Iteration over the policy therefore starts
+ * from the next eviction victim.  Capacity is counted in entries, or in bytes if a byte budget
+ * is set.
+ */
+struct wtinylfu_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "WTinyLfu";
+  }
+
+  enum segment { WINDOW, PROBATION, PROTECTED };
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    std::size_t hash; ///< @brief full-name hash, key of the frequency sketch
+    uint8_t segment;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    static policy_hook_type&
+    get_hook(typename Container::iterator item)
+    {
+      return *static_cast<policy_hook_type*>(policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    static const policy_hook_type&
+    get_hook(typename Container::const_iterator item)
+    {
+      return *static_cast<const policy_hook_type*>(
+               policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    typedef typename boost::intrusive::list<Container, Hook> policy_container;
+
+    class type : public policy_container {
+    public:
+      typedef policy policy_base; // to get access to get_hook methods from outside
+      typedef Container parent_trie;
+      typedef typename policy_container::iterator list_iterator;
+
+      type(Base& base)
+        : base_(base)
+        , max_size_(100)
+        , max_bytes_(0)
+        , window_(policy_container::end())
+        , protected_(policy_container::end())
+        , windowUnits_(0)
+        , probationUnits_(0)
+        , protectedUnits_(0)
+      {
+        resize_sketch();
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        touch(item);
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        if (capacity() != 0 && get_units(item) > capacity())
+          return false;
+
+        get_hook(item).hash = Base::s_node_hash(item);
+        sketch_.increment(get_hook(item).hash);
+        link(item, WINDOW);
+
+        if (capacity() == 0)
+          return true;
+
+        while (windowUnits_ > window_capacity() || over_max_size()) {
+          typename parent_trie::iterator candidate = &(*window_);
+          if (admit(candidate))
+            continue;
+
+          if (candidate == item) {
+            unlink(item);
+            return false;
+          }
+          base_.erase(candidate);
+        }
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        sketch_.increment(get_hook(item).hash);
+        touch(item);
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        unlink(item);
+      }
+
+      inline void
+      clear()
+      {
+        policy_container::clear();
+        window_ = protected_ = policy_container::end();
+        windowUnits_ = probationUnits_ = protectedUnits_ = 0;
+        sketch_.clear();
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        max_size_ = max_size;
+        resize_sketch();
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_size_;
+      }
+
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+        recount(); // units of the entries changed
+        resize_sketch();
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+      /**
+       * @brief Capacity in units: bytes if the byte budget is set, entries otherwise
+       */
+      size_t
+      capacity() const
+      {
+        return max_bytes_ != 0 ? max_bytes_ : max_size_;
+      }
+
+      size_t
+      window_capacity() const
+      {
+        return std::max<size_t>(capacity() / 100, 1);
+      }
+
+      size_t
+      main_capacity() const
+      {
+        return capacity() - std::min(window_capacity(), capacity());
+      }
+
+      size_t
+      protected_capacity() const
+      {
+        return main_capacity() * 4 / 5;
+      }
+
+      size_t
+      get_units(typename parent_trie::const_iterator item) const
+      {
+        return max_bytes_ != 0 ? Base::s_payload_size(item) : 1;
+      }
+
+      size_t&
+      segment_units(uint8_t segment)
+      {
+        return segment == WINDOW ? windowUnits_
+                                 : (segment == PROBATION ? probationUnits_ : protectedUnits_);
+      }
+
+      /**
+       * @brief Check the entry count limit, when capacity is counted in bytes
+       */
+      bool
+      over_max_size() const
+      {
+        return max_bytes_ != 0 && max_size_ != 0 && policy_container::size() > max_size_;
+      }
+
+      bool
+      main_fits(size_t units) const
+      {
+        return probationUnits_ + protectedUnits_ + units <= main_capacity() && !over_max_size();
+      }
+
+      /**
+       * @brief Move the window's candidate into the probationary segment
+       *
+       * Main region entries are evicted as long as there is not enough room for the candidate
+       * and the candidate is estimated to be more popular than the next victim.
+       *
+       * @returns false if the candidate should be evicted instead
+       */
+      bool
+      admit(typename parent_trie::iterator candidate)
+      {
+        size_t units = get_units(candidate);
+        while (!main_fits(units)) {
+          if (probationUnits_ + protectedUnits_ == 0)
+            return false; // would not fit even into the empty main region
+
+          typename parent_trie::iterator victim = &(*policy_container::begin());
+          if (sketch_.estimate(get_hook(candidate).hash) <= sketch_.estimate(get_hook(victim).hash))
+            return false;
+
+          base_.erase(victim);
+        }
+
+        unlink(candidate);
+        link(candidate, PROBATION);
+        return true;
+      }
+
+      void
+      touch(typename parent_trie::iterator item)
+      {
+        uint8_t segment = get_hook(item).segment;
+        unlink(item);
+
+        if (segment == WINDOW) {
+          link(item, WINDOW);
+          return;
+        }
+
+        link(item, PROTECTED);
+        while (protectedUnits_ > protected_capacity()) {
+          typename parent_trie::iterator demoted = &(*protected_);
+          unlink(demoted);
+          link(demoted, PROBATION);
+        }
+      }
+
+      void
+      link(typename parent_trie::iterator item, uint8_t segment)
+      {
+        get_hook(item).segment = segment;
+        segment_units(segment) += get_units(item);
+
+        if (segment == PROBATION) {
+          policy_container::insert(protected_, *item);
+        }
+        else if (segment == PROTECTED) {
+          list_iterator position = policy_container::insert(window_, *item);
+          if (protected_ == window_)
+            protected_ = position;
+        }
+        else {
+          list_iterator position = policy_container::insert(policy_container::end(), *item);
+          if (window_ == policy_container::end()) {
+            if (protected_ == window_)
+              protected_ = position;
+            window_ = position;
+          }
+        }
+      }
+
+      void
+      unlink(typename parent_trie::iterator item)
+      {
+        list_iterator position = policy_container::s_iterator_to(*item);
+        list_iterator next = position;
+        ++next;
+
+        // when the protected segment is empty, both boundaries point to the same entry
+        if (protected_ == position)
+          protected_ = next;
+        if (window_ == position)
+          window_ = next;
+
+        segment_units(get_hook(item).segment) -= get_units(item);
+        policy_container::erase(position);
+      }
+
+      void
+      resize_sketch()
+      {
+        // a few counters per cached entry keep collisions with one-time requests rare; assume
+        // 1 KB entries if only the byte budget is known
+        size_t entries = max_size_ != 0 ? max_size_ : max_bytes_ / 1024;
+        sketch_.resize(std::max<size_t>(4 * entries, 1024));
+      }
+
+      void
+      recount()
+      {
+        windowUnits_ = probationUnits_ = protectedUnits_ = 0;
+        for (list_iterator item = policy_container::begin(); item != policy_container::end();
+             item++) {
+          segment_units(get_hook(&(*item)).segment) += get_units(&(*item));
+        }
+      }
+
+    private:
+      Base& base_;
+      size_t max_size_;
+      size_t max_bytes_;
+
+      list_iterator window_;    ///< @brief first entry of the window, end() if window is empty
+      list_iterator protected_; ///< @brief first protected entry, window_ if segment is empty
+
+      size_t windowUnits_;
+      size_t probationUnits_;
+      size_t protectedUnits_;
+
+      detail::frequency_sketch sketch_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // WTINYLFU_POLICY_H_